@@ -0,0 +1,80 @@
+#include "animation.h"
+#include <math.h>
+
+static const float PI = 3.14159265f;
+
+void animInit(Animator* a) {
+    for (int i = 0; i < ANIM_CAPACITY; i++) a->tweens[i].kind = ANIM_NONE;
+    a->active = 0;
+}
+
+void animClear(Animator* a, Scene* s) {
+    for (int i = 0; i < ANIM_CAPACITY; i++) {
+        if (a->tweens[i].kind == ANIM_NONE) continue;
+        sceneInvalidateRect(s, a->tweens[i].area);
+        a->tweens[i].kind = ANIM_NONE;
+    }
+    a->active = 0;
+}
+
+int animStart(Animator* a, int kind, int target, uint32_t now, uint32_t delay,
+              uint32_t duration, uint32_t stagger, int elements, SceneRect area) {
+    int slot = -1;
+    for (int i = 0; i < ANIM_CAPACITY; i++) {
+        const Tween* t = &a->tweens[i];
+        if (t->kind == kind && t->target == target) {
+            slot = i;
+            break;
+        }
+        if (t->kind == ANIM_NONE && slot < 0) slot = i;
+    }
+    if (slot < 0) return 0;
+    Tween* t = &a->tweens[slot];
+    if (t->kind == ANIM_NONE) a->active++;
+    t->kind = kind;
+    t->target = target;
+    t->start = now + delay;
+    t->duration = duration > 0 ? duration : 1;
+    t->stagger = stagger;
+    t->elements = elements > 0 ? elements : 1;
+    t->area = area;
+    return 1;
+}
+
+float animProgress(const Animator* a, int kind, int target, int element, uint32_t now) {
+    if (a->active == 0) return -1;
+    for (int i = 0; i < ANIM_CAPACITY; i++) {
+        const Tween* t = &a->tweens[i];
+        if (t->kind != kind || t->target != target) continue;
+        // 用有符号差值比较，GetTickCount 回绕时也正确
+        int32_t elapsed = (int32_t)(now - t->start) - (int32_t)(element * t->stagger);
+        if (elapsed <= 0) return 0;
+        if (elapsed >= (int32_t)t->duration) return 1;
+        return (float)elapsed / t->duration;
+    }
+    return -1;
+}
+
+int animStep(Animator* a, Scene* s, uint32_t now) {
+    if (a->active == 0) return 0;
+    for (int i = 0; i < ANIM_CAPACITY; i++) {
+        Tween* t = &a->tweens[i];
+        if (t->kind == ANIM_NONE) continue;
+        sceneInvalidateRect(s, t->area);
+        uint32_t length = t->duration + (uint32_t)(t->elements - 1) * t->stagger;
+        if ((int32_t)(now - t->start) >= (int32_t)length) {
+            t->kind = ANIM_NONE;
+            a->active--;
+        }
+    }
+    return a->active;
+}
+
+float animShakeOffset(float t, float amplitude) {
+    return amplitude * sinf(t * 6 * PI) * (1 - t);
+}
+
+float animBounceOffset(float t, float height) {
+    if (t < 0.6f) return height * sinf(PI * t / 0.6f);
+    return height * 0.3f * sinf(PI * (t - 0.6f) / 0.4f);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <stdint.h>
+#include "scene.h"
+
+//按时间推进的动画：补间放在固定容量的数组里，开始、采样、回收都不分配内存。
+//动画只影响显示，游戏状态在开始动画前就已经更新，输入不需要等动画播完
+
+//动画种类
+enum {
+    ANIM_NONE,     // 空槽
+    ANIM_FLIP,     // 提交后逐格翻开
+    ANIM_SHAKE,    // 单词不合法时整行左右摇晃
+    ANIM_BOUNCE,   // 猜中后逐格跳起
+};
+
+const int ANIM_CAPACITY = 64;   // 同时播放的补间上限，满了新动画直接跳过（直接显示结果）
+
+//一个补间驱动 elements 个元素（例如一行的 5 个格子），第 i 个元素晚 i * stagger 毫秒开始
+struct Tween {
+    int kind;
+    int target;         // 由使用者解释，例如盘面与行号
+    uint32_t start;     // 第 0 个元素开始的时间（毫秒）
+    uint32_t duration;  // 每个元素的时长
+    uint32_t stagger;
+    int elements;
+    SceneRect area;     // 播放期间每帧重画的区域（包含元素移动能到达的范围）
+};
+
+struct Animator {
+    Tween tweens[ANIM_CAPACITY];
+    int active;
+};
+
+void animInit(Animator* a);
+//停止所有动画，并重画它们占据的区域
+void animClear(Animator* a, Scene* s);
+//开始一个补间，delay 毫秒后播放；同种类同目标的补间会被替换。没有空槽返回 0
+int animStart(Animator* a, int kind, int target, uint32_t now, uint32_t delay,
+              uint32_t duration, uint32_t stagger, int elements, SceneRect area);
+//第 element 个元素的进度：还没开始为 0，播放中为 0..1；没有这个补间（或已播完）返回 -1
+float animProgress(const Animator* a, int kind, int target, int element, uint32_t now);
+//每帧调用一次：重画所有播放中的区域，回收播完的补间（最后再重画一次），返回仍在播放的个数
+int animStep(Animator* a, Scene* s, uint32_t now);
+
+//曲线，t 为 0..1
+float animShakeOffset(float t, float amplitude);   // 衰减的左右摆动
+float animBounceOffset(float t, float height);     // 跳起后再小跳一次，返回向上的位移
@@ -0,0 +1,19 @@
+#include "arena.h"
+
+void arenaInit(Arena* a, size_t capacity) {
+    if (a->buf.size() != capacity) {
+        std::vector<uint8_t>().swap(a->buf);
+        a->buf.resize(capacity);
+    }
+    a->used = 0;
+    a->peak = 0;
+}
+
+void* arenaAlloc(Arena* a, size_t bytes, size_t align) {
+    uintptr_t base = (uintptr_t)a->buf.data();
+    uintptr_t p = (base + a->used + align - 1) & ~(uintptr_t)(align - 1);
+    if (p + bytes > base + a->buf.size()) return nullptr;
+    a->used = p + bytes - base;
+    if (a->used > a->peak) a->peak = a->used;
+    return (void*)p;
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+//线性分配器：初始化时一次性申请一整块内存，之后只移动指针。
+//按栈的方式使用：进入一层时记下位置（arenaMark），退出时整层退回（arenaRelease），
+//单个对象不需要也不能单独释放。空间不够时返回空指针，由调用方决定怎么退让
+struct Arena {
+    std::vector<uint8_t> buf;
+    size_t used;
+    size_t peak;        // 自上次 arenaResetPeak 以来用到的最大字节数
+};
+
+//capacity 与原来的一样大时不重新申请
+void arenaInit(Arena* a, size_t capacity);
+void* arenaAlloc(Arena* a, size_t bytes, size_t align);
+
+template <typename T>
+T* arenaArray(Arena* a, size_t n) {
+    return (T*)arenaAlloc(a, sizeof(T) * n, alignof(T));
+}
+
+inline size_t arenaMark(const Arena* a) { return a->used; }
+inline void arenaRelease(Arena* a, size_t mark) { a->used = mark; }
+inline void arenaResetPeak(Arena* a) { a->peak = a->used; }
+
+//定长节点池：节点用下标互相引用，回收的节点挂在空闲链表上重复使用。
+//容量在初始化时定好，用完后分配失败（返回 POOL_NONE），不会再去申请内存
+const uint32_t POOL_NONE = 0xFFFFFFFFu;
+
+template <typename T>
+struct NodePool {
+    std::vector<T> nodes;
+    std::vector<uint32_t> next_free;
+    uint32_t free_head;
+    uint32_t live;      // 正在使用的节点数
+    uint32_t peak;      // 自上次 poolResetPeak 以来同时使用的最多节点数
+};
+
+//一次性回收所有节点
+template <typename T>
+void poolClear(NodePool<T>* p) {
+    uint32_t capacity = (uint32_t)p->nodes.size();
+    for (uint32_t i = 0; i < capacity; i++) p->next_free[i] = i + 1 < capacity ? i + 1 : POOL_NONE;
+    p->free_head = capacity ? 0 : POOL_NONE;
+    p->live = 0;
+    p->peak = 0;
+}
+
+template <typename T>
+void poolInit(NodePool<T>* p, uint32_t capacity) {
+    p->nodes.resize(capacity);
+    p->next_free.resize(capacity);
+    poolClear(p);
+}
+
+template <typename T>
+uint32_t poolAlloc(NodePool<T>* p) {
+    uint32_t i = p->free_head;
+    if (i == POOL_NONE) return POOL_NONE;
+    p->free_head = p->next_free[i];
+    if (++p->live > p->peak) p->peak = p->live;
+    return i;
+}
+
+template <typename T>
+void poolFree(NodePool<T>* p, uint32_t i) {
+    p->next_free[i] = p->free_head;
+    p->free_head = i;
+    p->live--;
+}
+
+template <typename T>
+void poolResetPeak(NodePool<T>* p) { p->peak = p->live; }
@@ -0,0 +1,109 @@
+#include "daily.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char DAILY_MAGIC[8] = { 'W', 'D', 'A', 'I', 'L', 'Y', 'S', '1' };
+
+//文件头之后是 days 个 uint32 答案，再接 days 个 uint16 难度
+struct DailyHeader {
+    char magic[8];
+    uint64_t dict_hash;
+    int32_t count;
+    int32_t start_day;
+    int32_t days;
+    int32_t reserved;
+};
+
+// 公历换算（按 400 年周期计算，公元前的日期也成立）
+int32_t dailyDayNumber(int year, int month, int day) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yoe = year - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+void dailyDate(int32_t day_number, int* year, int* month, int* day) {
+    int32_t z = day_number + 719468;
+    int era = (z >= 0 ? z : z - 146096) / 146097;
+    int doe = z - era * 146097;
+    int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int mp = (5 * doy + 2) / 153;
+    *day = doy - (153 * mp + 2) / 5 + 1;
+    *month = mp < 10 ? mp + 3 : mp - 9;
+    *year = yoe + era * 400 + (*month <= 2);
+}
+
+int dailySave(const DailySchedule* s, const char* path) {
+    DailyHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, DAILY_MAGIC, sizeof(h.magic));
+    h.dict_hash = s->dict_hash;
+    h.count = s->count;
+    h.start_day = s->start_day;
+    h.days = (int32_t)s->targets.size();
+
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) return 0;
+    int ok = fwrite(&h, sizeof(h), 1, fp) == 1;
+    if (h.days > 0) {
+        ok = ok && fwrite(s->targets.data(), sizeof(uint32_t), h.days, fp) == (size_t)h.days;
+        ok = ok && fwrite(s->difficulty.data(), sizeof(uint16_t), h.days, fp) == (size_t)h.days;
+    }
+    ok = fclose(fp) == 0 && ok;
+    if (!ok) {
+        remove(tmp);
+        return 0;
+    }
+    if (rename(tmp, path) != 0) {
+        remove(path);   // Windows 下 rename 不能覆盖已有文件
+        if (rename(tmp, path) != 0) return 0;
+    }
+    return 1;
+}
+
+int dailyLoad(DailySchedule* s, const char* path, const Dictionary* d) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return 0;
+    DailyHeader h;
+    int ok = fread(&h, sizeof(h), 1, fp) == 1 && memcmp(h.magic, DAILY_MAGIC, sizeof(h.magic)) == 0;
+    // 词库内容变了，排期作废
+    ok = ok && h.dict_hash == d->hash && h.count == d->count;
+    // 答案不放回抽取，天数不会超过词数；文件长度也必须正好装下 days 天，损坏的文件不会去分配一大块内存
+    ok = ok && h.days >= 0 && h.days <= d->count;
+    if (ok) {
+        long expect = (long)sizeof(h) + (long)h.days * (long)(sizeof(uint32_t) + sizeof(uint16_t));
+        ok = fseek(fp, 0, SEEK_END) == 0 && ftell(fp) == expect && fseek(fp, (long)sizeof(h), SEEK_SET) == 0;
+    }
+    std::vector<uint32_t> targets;
+    std::vector<uint16_t> difficulty;
+    if (ok) {
+        targets.resize(h.days);
+        difficulty.resize(h.days);
+        ok = fread(targets.data(), sizeof(uint32_t), h.days, fp) == (size_t)h.days &&
+             fread(difficulty.data(), sizeof(uint16_t), h.days, fp) == (size_t)h.days;
+    }
+    fclose(fp);
+    if (!ok) return 0;
+    for (uint32_t t : targets) {
+        if (t >= (uint32_t)d->count) return 0;
+    }
+
+    s->dict_hash = h.dict_hash;
+    s->count = h.count;
+    s->start_day = h.start_day;
+    s->targets.swap(targets);
+    s->difficulty.swap(difficulty);
+    return 1;
+}
+
+uint32_t dailyLookup(const DailySchedule* s, const Dictionary* d, int32_t day_number) {
+    if (s->dict_hash != d->hash || s->count != d->count) return DAILY_NONE;
+    int64_t i = (int64_t)day_number - s->start_day;
+    if (i < 0 || i >= (int64_t)s->targets.size()) return DAILY_NONE;
+    return s->targets[(size_t)i];
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include "dictionary.h"
+
+const uint32_t DAILY_NONE = 0xFFFFFFFFu;
+
+//每日一题排期：由 wordle_daily 离线生成，从 start_day 起每天一个答案。
+//按日期查询只是一次下标计算；dict_hash 与当前词库不一致时整份作废
+struct DailySchedule {
+    uint64_t dict_hash;
+    int count;                          // 生成时词库的单词数
+    int32_t start_day;                  // 第一天（1970-01-01 起的天数）
+    std::vector<uint32_t> targets;      // 第 i 天的答案（词下标）
+    std::vector<uint16_t> difficulty;   // 第 i 天答案的难度（平均得分 * 100）
+};
+
+//公历日期与 1970-01-01 起的天数互相换算
+int32_t dailyDayNumber(int year, int month, int day);
+void dailyDate(int32_t day_number, int* year, int* month, int* day);
+
+int dailySave(const DailySchedule* s, const char* path);
+//读取排期，文件不存在、损坏或与词库不匹配时返回 0
+int dailyLoad(DailySchedule* s, const char* path, const Dictionary* d);
+//查某一天的答案，不在排期内或词库不符时返回 DAILY_NONE
+uint32_t dailyLookup(const DailySchedule* s, const Dictionary* d, int32_t day_number);
@@ -0,0 +1,569 @@
+#include "dictionary.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+static std::atomic<DictSnapshot> current_snapshot;
+
+DictSnapshot dictCurrent() {
+    return current_snapshot.load(std::memory_order_acquire);
+}
+
+void dictPublish(DictSnapshot snapshot) {
+    current_snapshot.store(std::move(snapshot), std::memory_order_release);
+}
+
+int encodeWord(const char* text, uint8_t* out) {
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        char c = text[i];
+        if (c >= 'a' && c <= 'z') c = c - 'a' + 'A';
+        if (c < 'A' || c > 'Z') return 0;
+        out[i] = (uint8_t)(c - 'A');
+    }
+    return 1;
+}
+
+int utf8Decode(const char* s, const char* end, uint32_t* cp) {
+    const uint8_t* p = (const uint8_t*)s;
+    size_t avail = end - s;
+    if (avail == 0) return 0;
+    if (p[0] < 0x80) {
+        *cp = p[0];
+        return 1;
+    }
+    int len;
+    uint32_t c, min;
+    if ((p[0] & 0xE0) == 0xC0) { len = 2; c = p[0] & 0x1F; min = 0x80; }
+    else if ((p[0] & 0xF0) == 0xE0) { len = 3; c = p[0] & 0x0F; min = 0x800; }
+    else if ((p[0] & 0xF8) == 0xF0) { len = 4; c = p[0] & 0x07; min = 0x10000; }
+    else return 0;
+    if (avail < (size_t)len) return 0;
+    for (int i = 1; i < len; i++) {
+        if ((p[i] & 0xC0) != 0x80) return 0;
+        c = (c << 6) | (p[i] & 0x3F);
+    }
+    // 过长编码、代理区和超出范围的码位都不合法
+    if (c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) return 0;
+    *cp = c;
+    return len;
+}
+
+int utf8Encode(uint32_t cp, char* out) {
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    }
+    if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        return 2;
+    }
+    if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+uint32_t foldSymbol(uint32_t cp) {
+    if (cp >= 'a' && cp <= 'z') return cp - 32;
+    if (cp >= 0xE0 && cp <= 0xFE && cp != 0xF7) return cp - 0x20;      // Latin-1：à..þ
+    if (cp == 0xFF) return 0x178;                                     // ÿ
+    // Latin Extended-A：多数成对排列，大写在前；0x139..0x148、0x179..0x17E 两段大写为奇数
+    if ((cp >= 0x100 && cp <= 0x137) || (cp >= 0x14A && cp <= 0x177)) return cp & ~1u;
+    if ((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17E)) return (cp & 1) ? cp : cp - 1;
+    if (cp == 0x3C2) return 0x3A3;                                    // 词尾 ς
+    if (cp >= 0x3B1 && cp <= 0x3C9) return cp - 0x20;                 // 希腊 α..ω
+    if (cp >= 0x430 && cp <= 0x44F) return cp - 0x20;                 // 西里尔 а..я
+    if (cp >= 0x450 && cp <= 0x45F) return cp - 0x50;                 // 西里尔 ѐ..џ
+    return cp;
+}
+
+int isWordSymbol(uint32_t cp) {
+    if (cp < 0x80) return (cp >= 'A' && cp <= 'Z') || (cp >= 'a' && cp <= 'z');
+    if (cp < 0xC0 || cp == 0xD7 || cp == 0xF7) return 0;
+    if (cp >= 0x300 && cp <= 0x36F) return 0;     // 组合附加符号，需要先合成为单个字母
+    if (cp >= 0x2000 && cp <= 0x2BFF) return 0;   // 标点、符号、箭头、制表符
+    if (cp >= 0x3000 && cp <= 0x303F) return 0;   // CJK 标点
+    if (cp >= 0xFE00 && cp <= 0xFE0F) return 0;   // 变体选择符
+    if (cp == 0xFEFF) return 0;
+    return 1;
+}
+
+static void setSymbol(Alphabet* a, int id, uint32_t cp) {
+    a->codes[id] = cp;
+    a->symbols[id][utf8Encode(cp, a->symbols[id])] = '\0';
+}
+
+void alphabetLatin(Alphabet* a) {
+    a->size = 26;
+    a->latin = 1;
+    for (int i = 0; i < 26; i++) setSymbol(a, i, 'A' + i);
+}
+
+int alphabetBuild(Alphabet* a, const uint32_t* codes, size_t n) {
+    int latin = 0;
+    std::vector<uint32_t> extra;
+    uint32_t last = 0;
+    for (size_t i = 0; i < n; i++) {
+        uint32_t cp = codes[i];
+        if (cp >= 'A' && cp <= 'Z') {
+            latin = 1;
+            continue;
+        }
+        if (cp == last) continue;
+        last = cp;
+        if (std::find(extra.begin(), extra.end(), cp) == extra.end()) {
+            extra.push_back(cp);
+            if ((int)extra.size() > MAX_ALPHABET) return 0;
+        }
+    }
+    if (latin * 26 + (int)extra.size() > MAX_ALPHABET) return 0;
+
+    // 其余符号的码位都大于 'Z'，排在 A..Z 之后即整体按码位升序
+    std::sort(extra.begin(), extra.end());
+    a->size = 0;
+    a->latin = latin;
+    if (latin) alphabetLatin(a);
+    for (uint32_t cp : extra) setSymbol(a, a->size++, cp);
+    return 1;
+}
+
+int alphabetParse(Alphabet* a, const char* symbols) {
+    const char* end = symbols + strlen(symbols);
+    a->size = 0;
+    for (const char* p = symbols; p < end;) {
+        uint32_t cp;
+        int len = utf8Decode(p, end, &cp);
+        if (!len || a->size >= MAX_ALPHABET) return 0;
+        setSymbol(a, a->size++, cp);
+        p += len;
+    }
+    a->latin = a->size >= 26;
+    for (int i = 0; i < 26 && a->latin; i++) {
+        if (a->codes[i] != (uint32_t)('A' + i)) a->latin = 0;
+    }
+    return 1;
+}
+
+int alphabetFind(const Alphabet* a, uint32_t cp) {
+    if (a->latin && cp >= 'A' && cp <= 'Z') return (int)(cp - 'A');
+    const uint32_t* end = a->codes + a->size;
+    const uint32_t* it = std::lower_bound(a->codes, end, cp);
+    return (it != end && *it == cp) ? (int)(it - a->codes) : -1;
+}
+
+int alphabetEncode(const Alphabet* a, const char* text, uint8_t* out) {
+    const char* end = text + strlen(text);
+    const char* p = text;
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        uint32_t cp;
+        int len = utf8Decode(p, end, &cp);
+        if (!len) return 0;
+        int id = alphabetFind(a, foldSymbol(cp));
+        if (id < 0) return 0;
+        out[i] = (uint8_t)id;
+        p += len;
+    }
+    return p == end;
+}
+
+void alphabetDecode(const Alphabet* a, const uint8_t* word, char* text) {
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        const char* sym = a->symbols[word[i]];
+        while (*sym) *text++ = *sym++;
+    }
+    *text = '\0';
+}
+
+//解析 [begin, end) 中的各行，begin 必须是行首
+//解析单词后面的权重列：[p, end) 为空白加一个非负有限数（后面还可有空白），或者只有空白
+static int parseWeight(const char* p, const char* end, float* weight, int* present) {
+    *weight = WORD_WEIGHT_DEFAULT;
+    *present = 0;
+    if (p < end && *p != ' ' && *p != '\t') return 0;
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t')) end--;
+    if (p == end) return 1;
+    char buf[64];
+    size_t len = (size_t)(end - p);
+    if (len >= sizeof(buf)) return 0;
+    memcpy(buf, p, len);
+    buf[len] = '\0';
+    char* stop;
+    double v = strtod(buf, &stop);
+    if (stop != buf + len || !(v >= 0) || v > 3.0e38) return 0;   // !(v >= 0) 同时排除 NaN
+    *weight = (float)v;
+    *present = 1;
+    return 1;
+}
+
+static void parseLines(const char* text, size_t begin, size_t end, std::vector<uint32_t>& codes,
+                       std::vector<float>* weights, int* has_weights, std::vector<size_t>* bad_lines) {
+    size_t pos = begin;
+    // 跳过 UTF-8 BOM
+    if (pos == 0 && end >= 3 && memcmp(text, "\xEF\xBB\xBF", 3) == 0) pos = 3;
+    while (pos < end) {
+        const char* nl = (const char*)memchr(text + pos, '\n', end - pos);
+        size_t stop = nl ? (size_t)(nl - text) : end;
+        size_t next = nl ? stop + 1 : end;
+        if (stop > pos && text[stop - 1] == '\r') stop--;
+        if (stop == pos || text[pos] == '#') {
+            pos = next;
+            continue;
+        }
+
+        uint32_t w[WORD_LENGTH];
+        int n = 0;
+        const char* p = text + pos;
+        const char* line_end = text + stop;
+        while (p < line_end && n < WORD_LENGTH) {
+            uint32_t cp;
+            int len = utf8Decode(p, line_end, &cp);
+            if (!len || !isWordSymbol(cp)) break;
+            w[n++] = foldSymbol(cp);
+            p += len;
+        }
+        float weight;
+        int present;
+        if (n == WORD_LENGTH && parseWeight(p, line_end, &weight, &present)) {
+            codes.insert(codes.end(), w, w + WORD_LENGTH);
+            if (weights) weights->push_back(weight);
+            if (present) *has_weights = 1;
+        } else if (bad_lines) {
+            bad_lines->push_back(pos);
+        }
+        pos = next;
+    }
+}
+
+//小于这个大小的文本不值得开线程
+const size_t PARALLEL_PARSE_BYTES = 1 << 20;
+
+void dictParseText(const char* text, size_t len, std::vector<uint32_t>& codes, std::vector<float>* weights,
+                   int* has_weights, std::vector<size_t>* bad_lines) {
+    int any_weight = 0;
+    if (!has_weights) has_weights = &any_weight;
+    *has_weights = 0;
+    int threads = (int)std::thread::hardware_concurrency();
+    if (threads < 1 || len < PARALLEL_PARSE_BYTES) threads = 1;
+    if (threads == 1) {
+        parseLines(text, 0, len, codes, weights, has_weights, bad_lines);
+        return;
+    }
+
+    // 按字节均分，每块的边界挪到下一行行首，各线程结果按块顺序拼接
+    std::vector<size_t> bounds(threads + 1);
+    bounds[0] = 0;
+    bounds[threads] = len;
+    for (int t = 1; t < threads; t++) {
+        size_t b = len * t / threads;
+        if (b < bounds[t - 1]) b = bounds[t - 1];
+        const char* nl = (const char*)memchr(text + b, '\n', len - b);
+        bounds[t] = nl ? (size_t)(nl - text) + 1 : len;
+    }
+    std::vector<std::vector<uint32_t>> part_codes(threads);
+    std::vector<std::vector<float>> part_weights(threads);
+    std::vector<int> part_has(threads, 0);
+    std::vector<std::vector<size_t>> part_bad(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            parseLines(text, bounds[t], bounds[t + 1], part_codes[t], weights ? &part_weights[t] : nullptr,
+                       &part_has[t], bad_lines ? &part_bad[t] : nullptr);
+        });
+    }
+    for (auto& w : workers) w.join();
+    for (int t = 0; t < threads; t++) {
+        codes.insert(codes.end(), part_codes[t].begin(), part_codes[t].end());
+        if (weights) weights->insert(weights->end(), part_weights[t].begin(), part_weights[t].end());
+        if (part_has[t]) *has_weights = 1;
+        if (bad_lines) bad_lines->insert(bad_lines->end(), part_bad[t].begin(), part_bad[t].end());
+    }
+}
+
+void alphabetMapCodes(const Alphabet* a, const uint32_t* codes, size_t n, uint8_t* out) {
+    for (size_t i = 0; i < n; i++) out[i] = (uint8_t)alphabetFind(a, codes[i]);
+}
+
+//5 个字母按 6 位一组打包，整数顺序即字典序
+static uint64_t packWord(const uint8_t* w) {
+    uint64_t key = 0;
+    for (int i = 0; i < WORD_LENGTH; i++) key = (key << 6) | w[i];
+    return key;
+}
+
+static void unpackWord(uint64_t key, uint8_t* w) {
+    for (int i = WORD_LENGTH - 1; i >= 0; i--) {
+        w[i] = (uint8_t)(key & 63);
+        key >>= 6;
+    }
+}
+
+// 构建期间尚未定型的节点（当前单词路径上的节点）
+struct PendingNode {
+    uint64_t mask;
+    uint32_t child[MAX_ALPHABET];
+};
+
+struct DawgBuilder {
+    Dictionary* d;
+    std::unordered_map<std::string, uint32_t> registry;
+
+    // 结构相同（出边字母与子节点都相同）的节点只保留一份
+    uint32_t registerNode(const PendingNode& p) {
+        std::string key((const char*)&p.mask, sizeof(p.mask));
+        uint32_t count = 0;
+        for (uint64_t rest = p.mask; rest; rest &= rest - 1) {
+            int c = __builtin_ctzll(rest);
+            key.append((const char*)&p.child[c], sizeof(uint32_t));
+            count += d->nodes[p.child[c]].count;
+        }
+        auto it = registry.find(key);
+        if (it != registry.end()) return it->second;
+
+        DawgNode node;
+        node.mask = p.mask;
+        node.first = (uint32_t)d->edges.size();
+        node.count = count;
+        for (uint64_t rest = p.mask; rest; rest &= rest - 1) {
+            d->edges.push_back(p.child[__builtin_ctzll(rest)]);
+        }
+        uint32_t id = (uint32_t)d->nodes.size();
+        d->nodes.push_back(node);
+        registry.emplace(std::move(key), id);
+        return id;
+    }
+};
+
+static void countFrequencies(Dictionary* d) {
+    memset(d->pos_freq, 0, sizeof(d->pos_freq));
+    memset(d->letter_freq, 0, sizeof(d->letter_freq));
+    for (int i = 0; i < d->count; i++) {
+        const uint8_t* w = dictWord(d, i);
+        uint64_t seen = 0;
+        for (int p = 0; p < WORD_LENGTH; p++) {
+            d->pos_freq[p][w[p]]++;
+            if (!(seen & (1ull << w[p]))) d->letter_freq[w[p]]++;
+            seen |= 1ull << w[p];
+        }
+    }
+}
+
+static void buildIndex(Dictionary* d) {
+    LetterIndex* idx = &d->index;
+    int size = d->alphabet.size;
+    idx->blocks = (d->count + 63) / 64;
+    idx->bits.assign((size_t)2 * WORD_LENGTH * size * idx->blocks, 0);
+    for (int i = 0; i < d->count; i++) {
+        const uint8_t* w = dictWord(d, i);
+        uint64_t bit = 1ull << (i & 63);
+        int block = i >> 6;
+        int seen[MAX_ALPHABET] = {0};
+        for (int p = 0; p < WORD_LENGTH; p++) {
+            int k = ++seen[w[p]];
+            idx->bits[(size_t)(p * size + w[p]) * idx->blocks + block] |= bit;
+            idx->bits[(size_t)(WORD_LENGTH * size + w[p] * WORD_LENGTH + k - 1) * idx->blocks + block] |= bit;
+        }
+    }
+}
+
+//按权重建出题抽样表，并数出能当答案的单词数
+static void buildTargets(Dictionary* d) {
+    const float* w = dictWeights(d);
+    aliasBuild(&d->targets, w, d->count);
+    d->target_count = d->count;
+    if (d->targets.threshold.empty()) return;   // 等概率（或权重全为 0）
+    d->target_count = 0;
+    for (int i = 0; i < d->count; i++) d->target_count += w[i] > 0;
+}
+
+void dictBuild(Dictionary* d, const Alphabet* a, std::vector<uint8_t>& words, const std::vector<float>* weights) {
+    d->alphabet = *a;
+    size_t n = words.size() / WORD_LENGTH;
+    std::vector<uint64_t> keys(n);
+    for (size_t i = 0; i < n; i++) keys[i] = packWord(&words[i * WORD_LENGTH]);
+    d->weights.clear();
+    if (weights) {
+        // 带权重时按 (单词, 权重) 排序，重复的词保留最后一个即最大的权重
+        std::vector<std::pair<uint64_t, float>> items(n);
+        for (size_t i = 0; i < n; i++) items[i] = { keys[i], (*weights)[i] };
+        std::sort(items.begin(), items.end());
+        keys.clear();
+        for (size_t i = 0; i < n; i++) {
+            if (i + 1 < n && items[i + 1].first == items[i].first) continue;
+            keys.push_back(items[i].first);
+            d->weights.push_back(items[i].second);
+        }
+    } else {
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    }
+
+    d->count = (int)keys.size();
+    d->letters.assign(keys.size() * WORD_LENGTH, 0);
+    for (size_t i = 0; i < keys.size(); i++) unpackWord(keys[i], &d->letters[i * WORD_LENGTH]);
+    words = d->letters;
+    buildTargets(d);
+
+    d->nodes.clear();
+    d->edges.clear();
+    d->nodes.push_back({0, 0, 1}); // DAWG_SINK
+
+    // 输入已排序，可按 Daciuk 增量算法逐词构建：
+    // 新词与上一个词分叉后，上一个词在分叉点以下的节点不会再改变，立即定型并合并
+    DawgBuilder b = { d, {} };
+    PendingNode path[WORD_LENGTH];
+    memset(path, 0, sizeof(path));
+    const uint8_t* prev = nullptr;
+
+    for (int i = 0; i < d->count; i++) {
+        const uint8_t* w = dictWord(d, i);
+        int common = 0;
+        if (prev) {
+            while (common < WORD_LENGTH && prev[common] == w[common]) common++;
+            for (int depth = WORD_LENGTH - 1; depth >= common; depth--) {
+                uint32_t child = (depth == WORD_LENGTH - 1) ? DAWG_SINK : b.registerNode(path[depth + 1]);
+                path[depth].child[prev[depth]] = child;
+            }
+            for (int depth = common + 1; depth < WORD_LENGTH; depth++) path[depth].mask = 0;
+        }
+        for (int depth = common; depth < WORD_LENGTH; depth++) path[depth].mask |= 1ull << w[depth];
+        prev = w;
+    }
+
+    if (prev) {
+        for (int depth = WORD_LENGTH - 1; depth >= 0; depth--) {
+            uint32_t child = (depth == WORD_LENGTH - 1) ? DAWG_SINK : b.registerNode(path[depth + 1]);
+            path[depth].child[prev[depth]] = child;
+        }
+    }
+    d->root = b.registerNode(path[0]);
+    buildIndex(d);
+    countFrequencies(d);
+
+    d->hash = 0xCBF29CE484222325ull;
+    for (int i = 0; i < a->size; i++) {
+        for (int k = 0; k < 4; k++) d->hash = (d->hash ^ ((a->codes[i] >> (8 * k)) & 0xFF)) * 0x100000001B3ull;
+    }
+    for (size_t i = 0; i < d->letters.size(); i++) {
+        d->hash = (d->hash ^ d->letters[i]) * 0x100000001B3ull;
+    }
+}
+
+void dictLoadTable(Dictionary* d, const DictTable* t) {
+    alphabetParse(&d->alphabet, t->alphabet);
+    d->count = t->count;
+    d->letters.assign(t->letters, t->letters + (size_t)t->count * WORD_LENGTH);
+    d->nodes.assign(t->nodes, t->nodes + t->node_count);
+    d->edges.assign(t->edges, t->edges + t->edge_count);
+    d->root = t->root;
+    d->hash = t->hash;
+    memcpy(d->pos_freq, t->pos_freq, sizeof(d->pos_freq));
+    memcpy(d->letter_freq, t->letter_freq, sizeof(d->letter_freq));
+    if (t->weights) d->weights.assign(t->weights, t->weights + t->count);
+    else d->weights.clear();
+    buildIndex(d);
+    buildTargets(d);
+}
+
+int dictLoadFile(Dictionary* d, const char* path) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return 0;
+    std::vector<char> text;
+    char buf[1 << 16];
+    size_t got;
+    while ((got = fread(buf, 1, sizeof(buf), fp)) > 0) text.insert(text.end(), buf, buf + got);
+    fclose(fp);
+
+    std::vector<uint32_t> codes;
+    std::vector<float> weights;
+    int has_weights;
+    dictParseText(text.data(), text.size(), codes, &weights, &has_weights, nullptr);
+    Alphabet a;
+    if (!alphabetBuild(&a, codes.data(), codes.size())) return 0;
+    std::vector<uint8_t> words(codes.size());
+    alphabetMapCodes(&a, codes.data(), codes.size(), words.data());
+    dictBuild(d, &a, words, has_weights ? &weights : nullptr);
+    return 1;
+}
+
+int dictContains(const Dictionary* d, const uint8_t* word) {
+    uint32_t node = d->root;
+    for (int i = 0; i < WORD_LENGTH && node != DAWG_NONE; i++) {
+        node = dictStep(d, node, word[i]);
+    }
+    return node == DAWG_SINK;
+}
+
+int dictIndexOf(const Dictionary* d, const uint8_t* word) {
+    int lo = 0, hi = d->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        int c = memcmp(dictWord(d, mid), word, WORD_LENGTH);
+        if (c == 0) return mid;
+        if (c < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return -1;
+}
+
+static uint32_t walkPrefix(const Dictionary* d, const uint8_t* prefix, int len) {
+    uint32_t node = d->root;
+    for (int i = 0; i < len && node != DAWG_NONE; i++) {
+        node = dictStep(d, node, prefix[i]);
+    }
+    return node;
+}
+
+int dictPrefixCount(const Dictionary* d, const uint8_t* prefix, int len) {
+    uint32_t node = walkPrefix(d, prefix, len);
+    return node == DAWG_NONE ? 0 : (int)d->nodes[node].count;
+}
+
+int dictCompletions(const Dictionary* d, const uint8_t* prefix, int len, uint8_t* out, int max_out) {
+    uint32_t stack_node[WORD_LENGTH + 1];
+    uint64_t stack_rest[WORD_LENGTH + 1];   // 该层尚未访问的出边 mask
+    uint8_t word[WORD_LENGTH];
+
+    uint32_t start = walkPrefix(d, prefix, len);
+    if (start == DAWG_NONE || max_out <= 0) return 0;
+    memcpy(word, prefix, len);
+
+    int found = 0;
+    int depth = len;
+    stack_node[depth] = start;
+    stack_rest[depth] = d->nodes[start].mask;
+    while (depth >= len) {
+        if (depth == WORD_LENGTH) {
+            memcpy(out + (size_t)found * WORD_LENGTH, word, WORD_LENGTH);
+            if (++found >= max_out) break;
+            depth--;
+            continue;
+        }
+        uint64_t rest = stack_rest[depth];
+        if (!rest) {
+            depth--;
+            continue;
+        }
+        int c = __builtin_ctzll(rest);
+        stack_rest[depth] = rest & (rest - 1);
+        word[depth] = (uint8_t)c;
+        uint32_t child = dictStep(d, stack_node[depth], c);
+        depth++;
+        stack_node[depth] = child;
+        stack_rest[depth] = d->nodes[child].mask;
+    }
+    return found;
+}
@@ -0,0 +1,165 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include "sampling.h"
+
+const int WORD_LENGTH = 5;
+const int MAX_ALPHABET = 64;                              // 字母表最多 64 个符号，出边/字母集合用 uint64_t 位掩码
+const int SYMBOL_BYTES = 4;                               // 一个符号的 UTF-8 编码最多 4 字节
+const int WORD_TEXT_MAX = WORD_LENGTH * SYMBOL_BYTES + 1; // 单词 UTF-8 文本缓冲区大小（含结尾 '\0'）
+const float WORD_WEIGHT_DEFAULT = 1.0f;                   // 没写权重列的单词的出题权重
+
+const uint32_t DAWG_NONE = 0xFFFFFFFFu;
+const uint32_t DAWG_SINK = 0;   // 所有单词共用的终止节点
+
+// 最小化 DAWG 节点：mask 第 c 位为 1 表示有字母 c 的出边，
+// 出边按字母顺序连续存放在 edges[first...] 中
+struct DawgNode {
+    uint64_t mask;
+    uint32_t first;
+    uint32_t count;   // 从该节点出发能拼出的单词数
+};
+
+//位图索引：每个位图 blocks 个 uint64_t，第 i 位对应第 i 个单词，只为字母表里的符号建位图
+//  位置索引 (pos, c)：第 pos 位是字母 c
+//  计数索引 (c, k)：字母 c 至少出现 k 次（k = 1..WORD_LENGTH）
+struct LetterIndex {
+    int blocks;
+    std::vector<uint64_t> bits;
+};
+
+//字母表：词库中出现的符号按码位升序编号为 0..size-1，打分、DAWG、索引都只用编号。
+//词库含基本拉丁字母时 A..Z 整段收入（编号 0..25，latin 为 1），英文词库的编号与原来一致
+struct Alphabet {
+    int size;
+    int latin;
+    uint32_t codes[MAX_ALPHABET];                       // 码位（已转大写）
+    char symbols[MAX_ALPHABET][SYMBOL_BYTES + 1];       // UTF-8 文本
+};
+
+//词库：排序去重后的单词（每词 WORD_LENGTH 个字母编号）+ DAWG + 位图索引 + 出题抽样表
+struct Dictionary {
+    int count;
+    Alphabet alphabet;
+    std::vector<uint8_t> letters;
+    std::vector<float> weights;   // 出题权重，与 letters 同序；为空表示等概率。权重为 0 的词只能猜，不会当答案
+    AliasTable targets;           // 按 weights 建的别名表，装入时建好
+    int target_count;             // 能当答案（权重 > 0）的单词数
+    std::vector<DawgNode> nodes;
+    std::vector<uint32_t> edges;
+    uint32_t root;
+    LetterIndex index;
+    uint64_t hash;   // 词库内容（字母表与单词，不含权重）的 FNV-1a 哈希，用于校验缓存/断点文件
+    uint32_t pos_freq[WORD_LENGTH][MAX_ALPHABET]; // 第 p 位是字母 c 的单词数
+    uint32_t letter_freq[MAX_ALPHABET];           // 含有字母 c 的单词数
+};
+
+//构建期由 wordgen 生成的词库表（见 words_table.h），启动时直接装入，无需解析文本
+struct DictTable {
+    int count;
+    const uint8_t* letters;
+    const DawgNode* nodes;
+    int node_count;
+    const uint32_t* edges;
+    int edge_count;
+    uint32_t root;
+    uint64_t hash;
+    const uint32_t (*pos_freq)[MAX_ALPHABET];
+    const uint32_t* letter_freq;
+    const char* alphabet;   // 字母表各符号的 UTF-8 文本首尾相连
+    const float* weights;   // 出题权重，词库没有权重列时为空
+};
+
+//编码转换（只用于基本拉丁字母，alphabet.latin 为 1 的词库编号与此一致）：
+//'A'..'Z'（大小写均可）-> 0..25，遇到非字母返回 0；解码用 alphabetDecode
+int encodeWord(const char* text, uint8_t* out);
+
+//UTF-8：解码 [s, end) 开头的一个码位，返回字节数，不合法返回 0；编码返回写入的字节数
+int utf8Decode(const char* s, const char* end, uint32_t* cp);
+int utf8Encode(uint32_t cp, char* out);
+//转大写（拉丁、希腊、西里尔字母），其它码位原样返回
+uint32_t foldSymbol(uint32_t cp);
+//能否作为单词中的字母：ASCII 只允许 A-Z，其余为 U+00C0 起的字母区（不含 × ÷ 和标点、符号区）
+int isWordSymbol(uint32_t cp);
+
+//由单词的码位（每词 WORD_LENGTH 个，已转大写）确定字母表，符号超过 MAX_ALPHABET 个时返回 0
+int alphabetBuild(Alphabet* a, const uint32_t* codes, size_t n);
+//只有 A..Z 的字母表
+void alphabetLatin(Alphabet* a);
+//由首尾相连的 UTF-8 符号文本还原字母表
+int alphabetParse(Alphabet* a, const char* symbols);
+//码位对应的编号，不在字母表里返回 -1
+int alphabetFind(const Alphabet* a, uint32_t cp);
+//UTF-8 文本（大小写均可，恰好 WORD_LENGTH 个符号）<-> 字母编号
+int alphabetEncode(const Alphabet* a, const char* text, uint8_t* out);
+void alphabetDecode(const Alphabet* a, const uint8_t* word, char* text);
+
+//把 UTF-8 文本按行解析成单词码位（每词 WORD_LENGTH 个，已转大写），空行和 # 开头的行忽略。
+//单词后可以用空格或 Tab 隔开写一个非负的出题权重（例如词频），weights 不为空时每词写入一个，没写的为 WORD_WEIGHT_DEFAULT，
+//has_weights 不为空时记下是否有任何一行写了权重。
+//bad_lines 为空时跳过不合法的行，否则记下这些行的起始偏移。文本较大时分块多线程解析
+void dictParseText(const char* text, size_t len, std::vector<uint32_t>& codes, std::vector<float>* weights,
+                   int* has_weights, std::vector<size_t>* bad_lines);
+//码位 -> 字母编号，codes 中的符号都必须在字母表里
+void alphabetMapCodes(const Alphabet* a, const uint32_t* codes, size_t n, uint8_t* out);
+
+//建库：words 为 n*WORD_LENGTH 个字母表 a 中的编号，会被原地排序去重。
+//weights 为空表示等概率出题，否则为每个词的权重，重复的词取最大的权重
+void dictBuild(Dictionary* d, const Alphabet* a, std::vector<uint8_t>& words, const std::vector<float>* weights);
+//从 UTF-8 文本文件读取，每行一个单词（可带权重列），不合法的行被跳过；打不开文件或符号超过 MAX_ALPHABET 个返回 0
+int dictLoadFile(Dictionary* d, const char* path);
+//装入预先生成的词库表，只做内存拷贝和位图索引
+void dictLoadTable(Dictionary* d, const DictTable* t);
+
+//词库快照：建好后不再修改，通过引用计数共享。
+//对局开始时取一份当前快照并一直持有，热更新只替换“当前快照”，不影响进行中的对局
+typedef std::shared_ptr<const Dictionary> DictSnapshot;
+
+DictSnapshot dictCurrent();
+void dictPublish(DictSnapshot snapshot);
+
+inline const uint8_t* dictWord(const Dictionary* d, int i) {
+    return &d->letters[(size_t)i * WORD_LENGTH];
+}
+
+//按出题权重抽一个答案，O(1)；r 为均匀的 64 位随机数
+inline uint32_t dictSampleTarget(const Dictionary* d, uint64_t r) {
+    return aliasSample(&d->targets, r);
+}
+
+inline const float* dictWeights(const Dictionary* d) {
+    return d->weights.empty() ? nullptr : d->weights.data();
+}
+
+//第 i 个词能不能当答案：与出题抽样一致，没有权重列（或权重全为 0、按等概率出题）时每个词都能
+inline int dictIsTarget(const Dictionary* d, uint32_t i) {
+    return d->targets.threshold.empty() || d->weights[i] > 0;
+}
+
+//沿字母 letter 走一步，O(1)；无此前缀返回 DAWG_NONE
+inline uint32_t dictStep(const Dictionary* d, uint32_t node, int letter) {
+    if (node == DAWG_NONE) return DAWG_NONE;
+    uint64_t mask = d->nodes[node].mask;
+    uint64_t bit = 1ull << letter;
+    if (!(mask & bit)) return DAWG_NONE;
+    return d->edges[d->nodes[node].first + __builtin_popcountll(mask & (bit - 1))];
+}
+
+inline const uint64_t* indexPosition(const Dictionary* d, int pos, int letter) {
+    return &d->index.bits[(size_t)(pos * d->alphabet.size + letter) * d->index.blocks];
+}
+
+inline const uint64_t* indexAtLeast(const Dictionary* d, int letter, int k) {
+    size_t slot = WORD_LENGTH * d->alphabet.size + letter * WORD_LENGTH + (k - 1);
+    return &d->index.bits[slot * d->index.blocks];
+}
+
+int dictContains(const Dictionary* d, const uint8_t* word);
+//单词在词库中的下标（单词按字典序存放，二分查找），不在词库中时返回 -1
+int dictIndexOf(const Dictionary* d, const uint8_t* word);
+//以 prefix（长度 len）开头的单词数
+int dictPrefixCount(const Dictionary* d, const uint8_t* prefix, int len);
+//枚举以 prefix 开头的单词，按字典序写入 out（每词 WORD_LENGTH 字节），最多 max_out 个，返回写入个数
+int dictCompletions(const Dictionary* d, const uint8_t* prefix, int len, uint8_t* out, int max_out);
@@ -0,0 +1,648 @@
+#include "game_archive.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+static const char ARCHIVE_MAGIC[8] = { 'W', 'G', 'A', 'M', 'A', 'R', 'C', '1' };
+static const char BLOCK_MAGIC[4] = { 'W', 'B', 'L', 'K' };
+static const char TAIL_MAGIC[8] = { 'W', 'G', 'A', 'T', 'A', 'I', 'L', '1' };
+const uint32_t GUESS_NONE = 0xFFFFFFFFu;
+
+static int bitsFor(uint64_t max) {
+    int b = 0;
+    while (b < 64 && (max >> b)) b++;
+    return b;
+}
+
+static size_t packedWords(size_t n, int width) {
+    return (n * width + 63) / 64;
+}
+
+//低位在前连续存放，dst 必须先清零
+static void packColumn(uint64_t* dst, const uint32_t* src, size_t n, int width) {
+    if (width == 0) return;
+    for (size_t i = 0; i < n; i++) {
+        size_t bit = i * width;
+        size_t w = bit >> 6;
+        int off = (int)(bit & 63);
+        dst[w] |= (uint64_t)src[i] << off;
+        if (off + width > 64) dst[w + 1] |= (uint64_t)src[i] >> (64 - off);
+    }
+}
+
+static inline uint32_t unpackAt(const uint64_t* src, int width, size_t i) {
+    if (width == 0) return 0;
+    size_t bit = i * width;
+    size_t w = bit >> 6;
+    int off = (int)(bit & 63);
+    uint64_t v = src[w] >> off;
+    if (off + width > 64) v |= src[w + 1] << (64 - off);
+    return (uint32_t)(v & ((1ull << width) - 1));
+}
+
+//整列解码：每个值从它所在的字节起读 8 个字节再移位，循环里没有分支。
+//宽度不超过 32 位，最后一个值可能多读 7 个字节，块数据在内存里多留一个字的余量
+static void unpackColumn(const uint64_t* src, int width, size_t n, uint32_t* out) {
+    const uint8_t* bytes = (const uint8_t*)src;
+    uint64_t mask = (1ull << width) - 1;
+    for (size_t i = 0; i < n; i++) {
+        size_t bit = i * width;
+        uint64_t v;
+        memcpy(&v, bytes + (bit >> 3), sizeof(v));
+        out[i] = (uint32_t)((v >> (bit & 7)) & mask);
+    }
+}
+
+static uint32_t checksum(const uint64_t* data, size_t words) {
+    // FNV-1a，按 8 字节一步
+    uint64_t h = 1469598103934665603ull;
+    for (size_t i = 0; i < words; i++) h = (h ^ data[i]) * 1099511628211ull;
+    return (uint32_t)(h ^ (h >> 32));
+}
+
+//按块头算出各列的位置，返回数据总长（uint64 个数）
+static uint32_t layoutBlock(ArchiveBlock* b) {
+    const ArchiveBlockHeader* h = &b->h;
+    size_t at = 0;
+    b->col_players = (uint32_t)at;  at += h->player_count;
+    b->col_player = (uint32_t)at;   at += packedWords(h->games, h->player_bits);
+    b->col_target = (uint32_t)at;   at += packedWords(h->games, h->word_bits);
+    b->col_attempts = (uint32_t)at; at += packedWords(h->games, ARCHIVE_ATTEMPT_BITS);
+    b->col_flags = (uint32_t)at;    at += packedWords(h->games, ARCHIVE_FLAG_BITS);
+    b->col_time = (uint32_t)at;     at += packedWords(h->games, h->time_bits);
+    b->col_guess = (uint32_t)at;    at += packedWords(h->guesses, h->word_bits);
+    b->col_pattern = (uint32_t)at;  at += (h->guesses + 7) / 8;
+    return (uint32_t)at;
+}
+
+static void encodeBlock(ArchiveBlock* b, const std::vector<ArchiveGame>& games, uint64_t dict_hash, int word_bits) {
+    ArchiveBlockHeader* h = &b->h;
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, BLOCK_MAGIC, sizeof(h->magic));
+    uint32_t n = (uint32_t)games.size();
+    h->games = n;
+    h->dict_hash = dict_hash;
+    h->word_bits = (uint8_t)word_bits;
+
+    std::vector<uint64_t> players(n);
+    h->time_min = n ? games[0].time : 0;
+    h->time_max = h->time_min;
+    for (uint32_t i = 0; i < n; i++) {
+        const ArchiveGame* g = &games[i];
+        players[i] = g->player;
+        h->guesses += g->attempts;
+        h->time_min = std::min(h->time_min, g->time);
+        h->time_max = std::max(h->time_max, g->time);
+        h->kinds |= archiveKind(g->mode, g->hard);
+    }
+    std::sort(players.begin(), players.end());
+    players.erase(std::unique(players.begin(), players.end()), players.end());
+    h->player_count = (uint32_t)players.size();
+    h->player_bits = (uint8_t)bitsFor(players.empty() ? 0 : players.size() - 1);
+    // 一块的时间跨度超过 32 位时截断（不会真的发生，只防时钟异常）
+    uint64_t span = (uint64_t)(h->time_max - h->time_min);
+    h->time_bits = (uint8_t)bitsFor(std::min<uint64_t>(span, 0xFFFFFFFFu));
+
+    h->words = layoutBlock(b);
+    b->data.assign(h->words + 1, 0);
+    uint64_t* d = b->data.data();
+    if (!players.empty()) memcpy(d + b->col_players, players.data(), players.size() * sizeof(uint64_t));
+
+    std::vector<uint32_t> col(n), guess_col(h->guesses);
+    for (uint32_t i = 0; i < n; i++) {
+        col[i] = (uint32_t)(std::lower_bound(players.begin(), players.end(), games[i].player) - players.begin());
+    }
+    packColumn(d + b->col_player, col.data(), n, h->player_bits);
+    for (uint32_t i = 0; i < n; i++) col[i] = games[i].target;
+    packColumn(d + b->col_target, col.data(), n, h->word_bits);
+    for (uint32_t i = 0; i < n; i++) col[i] = (uint32_t)games[i].attempts;
+    packColumn(d + b->col_attempts, col.data(), n, ARCHIVE_ATTEMPT_BITS);
+    for (uint32_t i = 0; i < n; i++) {
+        col[i] = (games[i].won ? 1 : 0) | (games[i].hard ? 2 : 0) | (uint32_t)games[i].mode << 2;
+    }
+    packColumn(d + b->col_flags, col.data(), n, ARCHIVE_FLAG_BITS);
+    for (uint32_t i = 0; i < n; i++) {
+        col[i] = (uint32_t)std::min<uint64_t>((uint64_t)(games[i].time - h->time_min), 0xFFFFFFFFu);
+    }
+    packColumn(d + b->col_time, col.data(), n, h->time_bits);
+
+    uint8_t* patterns = (uint8_t*)(d + b->col_pattern);
+    size_t k = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        for (int r = 0; r < games[i].attempts; r++) {
+            guess_col[k] = games[i].guesses[r];
+            patterns[k] = games[i].patterns[r];
+            k++;
+        }
+    }
+    packColumn(d + b->col_guess, guess_col.data(), h->guesses, h->word_bits);
+    h->checksum = checksum(d, h->words);
+}
+
+//encodeBlock 的逆过程，用于把没满的最后一块读回 pending
+static void decodeBlock(const ArchiveBlock* b, std::vector<ArchiveGame>& out) {
+    const ArchiveBlockHeader* h = &b->h;
+    const uint64_t* d = b->data.data();
+    const uint64_t* players = d + b->col_players;
+    const uint8_t* patterns = (const uint8_t*)(d + b->col_pattern);
+    size_t k = 0;
+    for (uint32_t i = 0; i < h->games; i++) {
+        ArchiveGame g;
+        memset(&g, 0, sizeof(g));
+        g.player = players[unpackAt(d + b->col_player, h->player_bits, i)];
+        g.time = h->time_min + unpackAt(d + b->col_time, h->time_bits, i);
+        g.target = unpackAt(d + b->col_target, h->word_bits, i);
+        g.attempts = (int)unpackAt(d + b->col_attempts, ARCHIVE_ATTEMPT_BITS, i);
+        uint32_t flags = unpackAt(d + b->col_flags, ARCHIVE_FLAG_BITS, i);
+        g.won = flags & 1;
+        g.hard = (flags >> 1) & 1;
+        g.mode = (int)(flags >> 2);
+        for (int r = 0; r < g.attempts; r++, k++) {
+            g.guesses[r] = unpackAt(d + b->col_guess, h->word_bits, k);
+            g.patterns[r] = patterns[k];
+        }
+        out.push_back(g);
+    }
+}
+
+//文件超过 2 GB 时 long 不够用（Windows 下 long 是 32 位）
+static int seek64(FILE* fp, int64_t offset, int whence) {
+#if defined(_WIN32)
+    return _fseeki64(fp, offset, whence);
+#else
+    return fseeko(fp, (off_t)offset, whence);
+#endif
+}
+
+static int64_t tell64(FILE* fp) {
+#if defined(_WIN32)
+    return _ftelli64(fp);
+#else
+    return (int64_t)ftello(fp);
+#endif
+}
+
+static int64_t blockBytes(const ArchiveBlockHeader* h) {
+    return (int64_t)sizeof(ArchiveBlockHeader) + (int64_t)h->words * sizeof(uint64_t);
+}
+
+static int writeHeader(FILE* fp) {
+    return fwrite(ARCHIVE_MAGIC, sizeof(ARCHIVE_MAGIC), 1, fp) == 1;
+}
+
+static int writeBlock(FILE* fp, const ArchiveBlock* b) {
+    return fwrite(&b->h, sizeof(b->h), 1, fp) == 1 &&
+           fwrite(b->data.data(), sizeof(uint64_t), b->h.words, fp) == b->h.words;
+}
+
+//读一块的头并检查各列的布局与块头一致
+static int readBlockHeader(FILE* fp, ArchiveBlock* b) {
+    return fread(&b->h, sizeof(b->h), 1, fp) == 1 && memcmp(b->h.magic, BLOCK_MAGIC, sizeof(b->h.magic)) == 0 &&
+           layoutBlock(b) == b->h.words && b->h.player_count <= b->h.games;
+}
+
+//读整块数据并校验
+static int readBlockData(FILE* fp, ArchiveBlock* b) {
+    b->data.assign(b->h.words + 1, 0);
+    return fread(b->data.data(), sizeof(uint64_t), b->h.words, fp) == b->h.words &&
+           checksum(b->data.data(), b->h.words) == b->h.checksum;
+}
+
+static int replaceFile(const char* tmp, const char* path) {
+    if (rename(tmp, path) == 0) return 1;
+    remove(path);   // Windows 下 rename 不能覆盖已有文件
+    return rename(tmp, path) == 0;
+}
+
+//只保留文件的前 length 个字节：复制到临时文件再改名
+static int truncateFile(const char* path, int64_t length) {
+    char tmp[300];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* in = fopen(path, "rb");
+    if (!in) return 0;
+    FILE* out = fopen(tmp, "wb");
+    if (!out) {
+        fclose(in);
+        return 0;
+    }
+    std::vector<char> buf(1 << 20);
+    int ok = 1;
+    for (int64_t left = length; left > 0 && ok;) {
+        size_t n = (size_t)std::min<int64_t>(left, (int64_t)buf.size());
+        ok = fread(buf.data(), 1, n, in) == n && fwrite(buf.data(), 1, n, out) == n;
+        left -= (int64_t)n;
+    }
+    fclose(in);
+    ok = fclose(out) == 0 && ok;
+    if (!ok) {
+        remove(tmp);
+        return 0;
+    }
+    return replaceFile(tmp, path);
+}
+
+static void tailPath(const GameArchive* a, char* out, size_t size) {
+    snprintf(out, size, "%s.tail", a->path);
+}
+
+//.tail 文件：magic、它接在档案文件的哪个位置（tail_offset），然后是未封块的对局编码成的一块
+static int writeTail(GameArchive* a) {
+    char path[300], tmp[310];
+    tailPath(a, path, sizeof(path));
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) return 0;
+    int ok = fwrite(TAIL_MAGIC, sizeof(TAIL_MAGIC), 1, fp) == 1 &&
+             fwrite(&a->tail_offset, sizeof(a->tail_offset), 1, fp) == 1 && writeBlock(fp, &a->pending_block);
+    ok = fclose(fp) == 0 && ok;
+    if (!ok) {
+        remove(tmp);
+        return 0;
+    }
+    return replaceFile(tmp, path);
+}
+
+//.tail 文件接在 tail_offset 上且完好时读进 b；接的位置不对说明它已经封进档案文件，是旧的（下一局会覆盖它）
+static int readTail(GameArchive* a, ArchiveBlock* b) {
+    char path[300];
+    tailPath(a, path, sizeof(path));
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return 0;
+    char magic[8];
+    int64_t base;
+    int ok = fread(magic, sizeof(magic), 1, fp) == 1 && memcmp(magic, TAIL_MAGIC, sizeof(magic)) == 0 &&
+             fread(&base, sizeof(base), 1, fp) == 1 && base == a->tail_offset && readBlockHeader(fp, b) &&
+             readBlockData(fp, b);
+    fclose(fp);
+    return ok;
+}
+
+//档案文件打不开或内容不对时换个名字留着（.bad，已有时 .bad1、.bad2……），不覆盖以前留下的；
+//.tail 跟着改名，免得被当成新档案的未封块。改名失败返回 0
+static int setAside(const char* path) {
+    char bad[300], tail[300], bad_tail[310];
+    for (int k = 0; k < 100; k++) {
+        if (k == 0) snprintf(bad, sizeof(bad), "%s.bad", path);
+        else snprintf(bad, sizeof(bad), "%s.bad%d", path, k);
+        FILE* fp = fopen(bad, "rb");
+        if (fp) {
+            fclose(fp);
+            continue;
+        }
+        if (rename(path, bad) != 0) return 0;
+        snprintf(tail, sizeof(tail), "%s.tail", path);
+        snprintf(bad_tail, sizeof(bad_tail), "%s.tail", bad);
+        rename(tail, bad_tail);
+        return 1;
+    }
+    return 0;
+}
+
+//读块头时的结果：读到一块、文件到头、最后一块写到一半（块头完整、数据不够）、内容不对、读文件出错
+enum { SCAN_BLOCK, SCAN_END, SCAN_TORN, SCAN_CORRUPT, SCAN_IO };
+
+static int scanBlock(FILE* fp, int64_t offset, int64_t size, ArchiveBlock* b) {
+    if (offset == size) return SCAN_END;
+    if (size - offset < (int64_t)sizeof(ArchiveBlockHeader)) return SCAN_CORRUPT;
+    if (fread(&b->h, sizeof(b->h), 1, fp) != 1) return SCAN_IO;
+    if (memcmp(b->h.magic, BLOCK_MAGIC, sizeof(b->h.magic)) != 0 || layoutBlock(b) != b->h.words ||
+        b->h.player_count > b->h.games) {
+        return SCAN_CORRUPT;
+    }
+    if (offset + blockBytes(&b->h) > size) return SCAN_TORN;
+    b->offset = offset + (int64_t)sizeof(ArchiveBlockHeader);
+    b->data.assign(b->h.player_count + 1, 0);
+    if (fread(b->data.data(), sizeof(uint64_t), b->h.player_count, fp) != b->h.player_count ||
+        seek64(fp, b->offset + (int64_t)b->h.words * sizeof(uint64_t), SEEK_SET) != 0) {
+        return SCAN_IO;
+    }
+    return SCAN_BLOCK;
+}
+
+int archiveOpen(GameArchive* a, const char* path) {
+    snprintf(a->path, sizeof(a->path), "%s", path);
+    a->blocks.clear();
+    a->pending.clear();
+    a->pending_hash = 0;
+    a->pending_word_bits = 0;
+    a->pending_dirty = 1;
+    a->tail_offset = sizeof(ARCHIVE_MAGIC);
+    a->games = 0;
+
+    // 只读块头和玩家表，其余的数据跳过
+    FILE* fp = fopen(path, "rb");
+    if (!fp && errno != ENOENT) {
+        a->path[0] = '\0';     // 文件在但打不开（没有权限、被占用）：不动它，本次只记在内存里
+        return 0;
+    }
+    int64_t offset = sizeof(ARCHIVE_MAGIC), size = 0, cut = -1;
+    int state = SCAN_END;
+    ArchiveBlock last;
+    last.h.games = 0;
+    if (fp) {
+        char magic[8];
+        if (seek64(fp, 0, SEEK_END) != 0 || (size = tell64(fp)) < 0 || seek64(fp, 0, SEEK_SET) != 0) {
+            state = SCAN_IO;
+        } else if (size == 0) {
+            // 空文件：第一次封块时连文件头一起写
+        } else if (fread(magic, sizeof(magic), 1, fp) != 1) {
+            state = ferror(fp) ? SCAN_IO : SCAN_CORRUPT;
+        } else if (memcmp(magic, ARCHIVE_MAGIC, sizeof(magic)) != 0) {
+            state = SCAN_CORRUPT;
+        } else {
+            for (;;) {
+                ArchiveBlock b;
+                state = scanBlock(fp, offset, size, &b);
+                if (state != SCAN_BLOCK) break;
+                a->games += b.h.games;
+                a->blocks.push_back(std::move(b));
+                offset += blockBytes(&a->blocks.back().h);
+            }
+            if (state == SCAN_TORN) {
+                cut = offset;
+                state = SCAN_END;
+            }
+        }
+        // 只有最后一块会被改写（写入总在 tail_offset），整块读出来校验。校验不过时，
+        // 只有 .tail 正好接在它前面（这一块是封块写到一半，它的对局都在 .tail 里）才丢掉这一块
+        if (state == SCAN_END && !a->blocks.empty()) {
+            ArchiveBlock* b = &a->blocks.back();
+            int64_t start = b->offset - (int64_t)sizeof(ArchiveBlockHeader);
+            last.h = b->h;
+            layoutBlock(&last);
+            if (seek64(fp, b->offset, SEEK_SET) != 0) {
+                state = SCAN_IO;
+            } else if (!readBlockData(fp, &last)) {
+                ArchiveBlock tail;
+                a->tail_offset = start;
+                if (ferror(fp)) {
+                    state = SCAN_IO;
+                } else if (readTail(a, &tail)) {
+                    cut = offset = start;
+                    a->games -= b->h.games;
+                    a->blocks.pop_back();
+                    last.h.games = 0;
+                } else {
+                    state = SCAN_CORRUPT;
+                }
+            } else if (last.h.games >= (uint32_t)ARCHIVE_BLOCK_GAMES) {
+                last.h.games = 0;
+            }
+        }
+        fclose(fp);
+    }
+    if (state == SCAN_IO || (state == SCAN_CORRUPT && !setAside(path))) {
+        // 读文件出错，或者内容不对又没法挪开：不动文件，本次只记在内存里
+        a->blocks.clear();
+        a->games = 0;
+        a->tail_offset = sizeof(ARCHIVE_MAGIC);
+        a->path[0] = '\0';
+        return 0;
+    }
+    if (state == SCAN_CORRUPT) {
+        // 已改名为 .bad，从空档案开始
+        a->blocks.clear();
+        a->games = 0;
+        a->tail_offset = sizeof(ARCHIVE_MAGIC);
+        return 1;
+    }
+    // 写到一半退出留下的最后一块：只去掉这一块，前面完整的块不动
+    if (cut >= 0) truncateFile(path, cut);
+    a->tail_offset = offset;
+    // 没满的最后一块读回来接着攒。新块的每一列都不会比旧块短，原位置改写不会留下旧数据
+    if (last.h.games > 0) {
+        decodeBlock(&last, a->pending);
+        a->pending_hash = last.h.dict_hash;
+        a->pending_word_bits = last.h.word_bits;
+        a->tail_offset = offset - blockBytes(&last.h);
+        a->games -= last.h.games;
+        a->blocks.pop_back();
+    }
+    // 上次运行没正常退出时，.tail 里有比档案文件更新的对局
+    ArchiveBlock tail;
+    if (readTail(a, &tail) && tail.h.games >= a->pending.size()) {
+        a->pending.clear();
+        decodeBlock(&tail, a->pending);
+        a->pending_hash = tail.h.dict_hash;
+        a->pending_word_bits = tail.h.word_bits;
+    }
+    a->games += a->pending.size();
+    return 1;
+}
+
+//封块：编码 pending 写到 tail_offset（原位置改写没满的最后一块，或追加到末尾），之后 .tail 就没用了
+static int sealPending(GameArchive* a) {
+    if (a->pending.empty()) return 1;
+    ArchiveBlock b;
+    encodeBlock(&b, a->pending, a->pending_hash, a->pending_word_bits);
+    b.offset = a->tail_offset + (int64_t)sizeof(ArchiveBlockHeader);
+    a->pending.clear();
+    a->pending_dirty = 1;
+    int ok = 1;
+    if (a->path[0]) {
+        FILE* fp = fopen(a->path, "r+b");
+        if (!fp) fp = fopen(a->path, "wb");
+        ok = fp != nullptr;
+        // 第一块连文件头一起写（文件是新建的或是空的）
+        if (ok && a->tail_offset == (int64_t)sizeof(ARCHIVE_MAGIC)) ok = seek64(fp, 0, SEEK_SET) == 0 && writeHeader(fp);
+        ok = ok && seek64(fp, a->tail_offset, SEEK_SET) == 0 && writeBlock(fp, &b);
+        if (fp) ok = fclose(fp) == 0 && ok;
+        if (ok) {
+            char tail[300];
+            tailPath(a, tail, sizeof(tail));
+            remove(tail);
+        }
+    }
+    if (ok && a->path[0]) {
+        a->tail_offset += blockBytes(&b.h);
+        b.data.resize(b.h.player_count + 1);    // 数据已在文件里，内存中只留玩家表
+    } else {
+        b.offset = -1;                          // 没写进文件的块整块留在内存里
+    }
+    a->blocks.push_back(std::move(b));
+    return ok;
+}
+
+static void encodePending(GameArchive* a) {
+    if (!a->pending_dirty) return;
+    encodeBlock(&a->pending_block, a->pending, a->pending_hash, a->pending_word_bits);
+    a->pending_block.offset = -1;
+    a->pending_dirty = 0;
+}
+
+void archiveAppend(GameArchive* a, const Dictionary* d, const ArchiveGame* g) {
+    if (!a->pending.empty() && a->pending_hash != d->hash) sealPending(a);
+    a->pending_hash = d->hash;
+    a->pending_word_bits = bitsFor(d->count > 0 ? d->count - 1 : 0);
+    a->pending.push_back(*g);
+    a->pending_dirty = 1;
+    a->games++;
+    // 攒满时也先写 .tail：封块写到一半被打断，重新打开时还能从 .tail 找回
+    if (a->path[0]) {
+        encodePending(a);
+        writeTail(a);
+    }
+    if ((int)a->pending.size() >= ARCHIVE_BLOCK_GAMES) sealPending(a);
+}
+
+int archiveFlush(GameArchive* a) {
+    return sealPending(a);
+}
+
+//块是否可能有符合条件的对局；可能时返回 1 并给出块内的玩家编号（不限玩家时为 -1）
+static int blockMayMatch(const ArchiveBlock* b, const ArchiveFilter* f, int64_t* want_player) {
+    const ArchiveBlockHeader* h = &b->h;
+    if (h->games == 0) return 0;
+    if (f->since && h->time_max < f->since) return 0;
+    if (f->until && h->time_min >= f->until) return 0;
+    if (f->kinds && !(h->kinds & f->kinds)) return 0;
+    *want_player = -1;
+    if (f->player) {
+        const uint64_t* players = b->data.data() + b->col_players;
+        const uint64_t* end = players + h->player_count;
+        const uint64_t* it = std::lower_bound(players, end, f->player);
+        if (it == end || *it != f->player) return 0;
+        *want_player = it - players;
+    }
+    return 1;
+}
+
+//扫描时除了次数和标志还要解码哪些列
+enum { SCAN_TARGET = 1, SCAN_FIRST_GUESS = 2 };
+
+//取一块的一列（从 start 起 words 个 uint64）：未封块的对局直接用内存里的数据，
+//文件里的块读进 s->raw，多留一个字的余量给 unpackColumn；读不到时返回 nullptr
+static const uint64_t* column(FILE* fp, ArchiveScratch* s, const ArchiveBlock* b, uint32_t start, size_t words) {
+    if (b->offset < 0) return b->data.data() + start;
+    s->raw.resize(words + 1);
+    s->raw[words] = 0;
+    if (!fp || seek64(fp, b->offset + (int64_t)start * sizeof(uint64_t), SEEK_SET) != 0 ||
+        fread(s->raw.data(), sizeof(uint64_t), words, fp) != words) {
+        return nullptr;
+    }
+    return s->raw.data();
+}
+
+//把一块需要的列解码到 scratch，并按条件算出 keep；列读不出来时整块跳过（返回 0）
+static uint32_t scanBlock(FILE* fp, ArchiveScratch* s, const ArchiveBlock* b, const ArchiveFilter* f,
+                          int64_t want_player, int cols) {
+    const ArchiveBlockHeader* h = &b->h;
+    uint32_t n = h->games;
+    const uint64_t* col;
+    s->keep.resize(n);
+    s->attempts.resize(n);
+    s->flags.resize(n);
+    if (!(col = column(fp, s, b, b->col_attempts, packedWords(n, ARCHIVE_ATTEMPT_BITS)))) return 0;
+    unpackColumn(col, ARCHIVE_ATTEMPT_BITS, n, s->attempts.data());
+    if (!(col = column(fp, s, b, b->col_flags, packedWords(n, ARCHIVE_FLAG_BITS)))) return 0;
+    unpackColumn(col, ARCHIVE_FLAG_BITS, n, s->flags.data());
+    if (cols & SCAN_TARGET) {
+        s->target.resize(n);
+        if (!(col = column(fp, s, b, b->col_target, packedWords(n, h->word_bits)))) return 0;
+        unpackColumn(col, h->word_bits, n, s->target.data());
+    }
+
+    // 标志去掉胜负位正好是 mode * 2 + hard，即 kinds 中的位号
+    uint8_t* keep = s->keep.data();
+    const uint32_t* flags = s->flags.data();
+    uint32_t kinds = f->kinds ? f->kinds : 0xFFFFFFFFu;
+    for (uint32_t i = 0; i < n; i++) keep[i] = (kinds >> (flags[i] >> 1)) & 1;
+    if (want_player >= 0) {
+        s->player.resize(n);
+        if (!(col = column(fp, s, b, b->col_player, packedWords(n, h->player_bits)))) return 0;
+        unpackColumn(col, h->player_bits, n, s->player.data());
+        const uint32_t* player = s->player.data();
+        for (uint32_t i = 0; i < n; i++) keep[i] &= player[i] == (uint32_t)want_player;
+    }
+    if (f->since || f->until) {
+        s->time.resize(n);
+        if (!(col = column(fp, s, b, b->col_time, packedWords(n, h->time_bits)))) return 0;
+        unpackColumn(col, h->time_bits, n, s->time.data());
+        int64_t lo = f->since ? f->since - h->time_min : INT64_MIN;
+        int64_t hi = f->until ? f->until - h->time_min : INT64_MAX;
+        const uint32_t* time = s->time.data();
+        for (uint32_t i = 0; i < n; i++) keep[i] &= (int64_t)time[i] >= lo && (int64_t)time[i] < hi;
+    }
+    if (cols & SCAN_FIRST_GUESS) {
+        // 第 i 局的猜测从前面各局猜测次数之和开始
+        s->first_guess.resize(n);
+        if (!(col = column(fp, s, b, b->col_guess, packedWords(h->guesses, h->word_bits)))) return 0;
+        const uint32_t* attempts = s->attempts.data();
+        size_t at = 0;
+        for (uint32_t i = 0; i < n; i++) {
+            s->first_guess[i] = attempts[i] > 0 ? unpackAt(col, h->word_bits, at) : GUESS_NONE;
+            at += attempts[i];
+        }
+    }
+    return n;
+}
+
+//依次扫描所有块（最后是未封块的对局），每块扫完调用 fn(块, 局数)
+template <typename Fn>
+static void scanArchive(GameArchive* a, const ArchiveFilter* f, int cols, Fn fn) {
+    encodePending(a);
+    FILE* fp = a->path[0] ? fopen(a->path, "rb") : nullptr;
+    size_t total = a->blocks.size() + 1;
+    for (size_t i = 0; i < total; i++) {
+        const ArchiveBlock* b = i < a->blocks.size() ? &a->blocks[i] : &a->pending_block;
+        int64_t want_player;
+        if (!blockMayMatch(b, f, &want_player)) continue;
+        uint32_t n = scanBlock(fp, &a->scratch, b, f, want_player, cols);
+        fn(b, n);
+    }
+    if (fp) fclose(fp);
+}
+
+void archiveStats(GameArchive* a, const ArchiveFilter* f, Statistics* out) {
+    memset(out, 0, sizeof(*out));
+    ArchiveScratch* s = &a->scratch;
+    scanArchive(a, f, 0, [&](const ArchiveBlock*, uint32_t n) {
+        const uint8_t* keep = s->keep.data();
+        const uint32_t* flags = s->flags.data();
+        const uint32_t* attempts = s->attempts.data();
+        for (uint32_t i = 0; i < n; i++) {
+            if (!keep[i]) continue;
+            out->games_played++;
+            if (flags[i] & 1) {
+                out->games_won++;
+                out->current_streak++;
+                out->max_streak = std::max(out->max_streak, out->current_streak);
+                if (attempts[i] >= 1 && attempts[i] <= (uint32_t)MAX_ATTEMPTS) out->guess_distribution[attempts[i] - 1]++;
+            } else {
+                out->current_streak = 0;
+            }
+        }
+    });
+}
+
+void archiveOpeners(GameArchive* a, const Dictionary* d, const ArchiveFilter* f, uint32_t* counts) {
+    memset(counts, 0, sizeof(uint32_t) * d->count);
+    ArchiveScratch* s = &a->scratch;
+    scanArchive(a, f, SCAN_FIRST_GUESS, [&](const ArchiveBlock* b, uint32_t n) {
+        if (b->h.dict_hash != d->hash) return;
+        const uint8_t* keep = s->keep.data();
+        const uint32_t* first = s->first_guess.data();
+        for (uint32_t i = 0; i < n; i++) {
+            if (keep[i] && first[i] < (uint32_t)d->count) counts[first[i]]++;
+        }
+    });
+}
+
+void archiveTargetDistribution(GameArchive* a, const Dictionary* d, const ArchiveFilter* f, uint32_t* dist) {
+    const int K = MAX_ATTEMPTS + 1;
+    memset(dist, 0, sizeof(uint32_t) * d->count * K);
+    ArchiveScratch* s = &a->scratch;
+    scanArchive(a, f, SCAN_TARGET, [&](const ArchiveBlock* b, uint32_t n) {
+        if (b->h.dict_hash != d->hash) return;
+        const uint8_t* keep = s->keep.data();
+        const uint32_t* flags = s->flags.data();
+        const uint32_t* attempts = s->attempts.data();
+        const uint32_t* target = s->target.data();
+        for (uint32_t i = 0; i < n; i++) {
+            if (!keep[i] || target[i] >= (uint32_t)d->count) continue;
+            int k = (flags[i] & 1) && attempts[i] <= (uint32_t)MAX_ATTEMPTS ? (int)attempts[i] : 0;
+            dist[(size_t)target[i] * K + k]++;
+        }
+    });
+}
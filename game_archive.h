@@ -0,0 +1,101 @@
+#pragma once
+#include <stdint.h>
+#include <vector>
+#include "dictionary.h"
+#include "scoring.h"
+#include "player_stats.h"
+
+//对局档案：每局结束后追加一条，按列存放，供统计页面和分析工具做筛选统计。
+//每 ARCHIVE_BLOCK_GAMES 局封成一块，块内每列单独位压缩：
+//  玩家（块内字典编号）、答案（词下标）、猜测次数、标志（胜负/困难/模式）、时间（相对块内最早时间），
+//  所有猜测的词下标一列，反馈一列（每个 8 位）。
+//块头记下时间范围、出现过的模式和玩家表，筛选时整块跳过不相干的块；
+//内存里只留块头和玩家表，扫描时只从文件读要用的列，按列批量解码成数组再做简单循环，编译器可以向量化。
+//还没攒满一块的对局每局结束都写进旁边的 .tail 文件（先写临时文件再改名），进程被杀也不丢
+const int ARCHIVE_BLOCK_GAMES = 4096;
+const int ARCHIVE_ATTEMPT_BITS = 5;     // 猜测次数（单盘面最多 MAX_ATTEMPTS）
+const int ARCHIVE_FLAG_BITS = 4;        // 第 0 位猜中，第 1 位困难模式，第 2-3 位游戏模式
+
+//一局（只记单盘面的对局）
+struct ArchiveGame {
+    uint64_t player;
+    int64_t time;                       // Unix 时间（秒）
+    uint32_t target;
+    int mode;                           // 游戏模式，0..3
+    int hard;
+    int won;
+    int attempts;                       // 提交的行数
+    uint32_t guesses[MAX_ATTEMPTS];
+    uint8_t patterns[MAX_ATTEMPTS];
+};
+
+struct ArchiveBlockHeader {
+    char magic[4];
+    uint32_t games;
+    uint32_t guesses;                   // 所有对局的猜测总数
+    uint32_t player_count;
+    uint64_t dict_hash;                 // 词下标按这个词库解释
+    int64_t time_min, time_max;
+    uint8_t word_bits, player_bits, time_bits, reserved;
+    uint32_t kinds;                     // 出现过的（模式, 困难）组合，第 mode * 2 + hard 位
+    uint32_t words;                     // 块数据的 uint64 个数
+    uint32_t checksum;
+};
+
+//一块：头 + 数据，各列在数据里的起点（以 uint64 计）。
+//文件里的块 data 只有开头的玩家表，其余的列扫描时按 offset 读；未封块的对局 offset 为 -1，data 是全部数据
+struct ArchiveBlock {
+    ArchiveBlockHeader h;
+    int64_t offset;                     // 块数据在文件中的位置
+    std::vector<uint64_t> data;
+    uint32_t col_players, col_player, col_target, col_attempts, col_flags, col_time, col_guess, col_pattern;
+};
+
+//筛选条件，各项为 0 表示不限
+struct ArchiveFilter {
+    uint64_t player;
+    int64_t since, until;               // [since, until)
+    uint32_t kinds;                     // 要哪些（模式, 困难）组合，位的含义同块头的 kinds
+};
+
+//（模式, 困难）组合对应的 kinds 位
+inline uint32_t archiveKind(int mode, int hard) {
+    return 1u << (mode * 2 + (hard ? 1 : 0));
+}
+
+//扫描用的缓冲区，档案自带一份，扫描中不再分配
+struct ArchiveScratch {
+    std::vector<uint64_t> raw;          // 从文件读出的一列
+    std::vector<uint32_t> player, target, attempts, flags, time, first_guess;
+    std::vector<uint8_t> keep;
+};
+
+struct GameArchive {
+    char path[260];
+    std::vector<ArchiveBlock> blocks;
+    std::vector<ArchiveGame> pending;   // 还没封块的对局
+    uint64_t pending_hash;              // pending 按哪个词库记录，词库换了先封块
+    int pending_word_bits;
+    int64_t tail_offset;                // 下一块写在文件的哪里：最后一块没满时是它的位置（读回 pending 后原位置改写），否则是文件末尾
+    ArchiveBlock pending_block;         // pending 编码后的样子，扫描时与已封的块同样处理，也是 .tail 文件的内容
+    int pending_dirty;
+    ArchiveScratch scratch;
+    uint64_t games;                     // 总局数（含未封块的）
+};
+
+//读取档案文件的块头，文件不存在时为空档案。只有写到一半的最后一块（块头完整、数据不够，
+//或者校验不过而 .tail 里有它的对局）会从文件里去掉；其它内容不对的情况把文件改名为 .bad 留着，从空档案开始。
+//文件打不开或读出错时不动文件，返回 0，本次只记在内存里。
+//最后一块没满时读回未封块的对局，之后接着往里攒，不会每次运行都留下一个小块；.tail 文件比它新时用 .tail
+int archiveOpen(GameArchive* a, const char* path);
+//追加一局并写 .tail 文件，攒满一块时封块写入档案文件
+void archiveAppend(GameArchive* a, const Dictionary* d, const ArchiveGame* g);
+//把未封块的对局封成一块（可以不满）写入文件，退出前调用
+int archiveFlush(GameArchive* a);
+
+//筛选后的统计：局数、胜局、连胜（按记录顺序）、猜中次数分布
+void archiveStats(GameArchive* a, const ArchiveFilter* f, Statistics* out);
+//筛选后各个开局词（第一步）的使用次数，counts 长度为 d->count；只统计按词库 d 记录的对局
+void archiveOpeners(GameArchive* a, const Dictionary* d, const ArchiveFilter* f, uint32_t* counts);
+//筛选后按答案统计猜测次数分布：dist[target * (MAX_ATTEMPTS + 1) + k]，k = 0 为失败，1..MAX_ATTEMPTS 为猜中所用次数
+void archiveTargetDistribution(GameArchive* a, const Dictionary* d, const ArchiveFilter* f, uint32_t* dist);
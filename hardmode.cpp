@@ -0,0 +1,61 @@
+#include "hardmode.h"
+#include "scoring.h"
+#include <string.h>
+
+void hardCollect(HardConstraints* hc, const uint8_t* guesses, const uint8_t* patterns, int rows) {
+    for (int i = 0; i < WORD_LENGTH; i++) hc->fixed[i] = -1;
+    memset(hc->min_count, 0, sizeof(hc->min_count));
+
+    for (int row = 0; row < rows; row++) {
+        const uint8_t* g = guesses + row * WORD_LENGTH;
+        int result[WORD_LENGTH];
+        decodePattern(patterns[row], result);
+        for (int i = 0; i < WORD_LENGTH; i++) {
+            if (result[i] == 3) {
+                hc->fixed[i] = g[i];
+            }
+            if (result[i] == 3 || result[i] == 2) {
+                hc->min_count[g[i]] = 1;
+            }
+        }
+    }
+}
+
+int hardSatisfies(const HardConstraints* hc, const uint8_t* word) {
+    uint8_t cnt[MAX_ALPHABET] = {0};
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        if (hc->fixed[i] >= 0 && word[i] != hc->fixed[i]) return 0;
+        cnt[word[i]]++;
+    }
+    for (int c = 0; c < MAX_ALPHABET; c++) {
+        if (cnt[c] < hc->min_count[c]) return 0;
+    }
+    return 1;
+}
+
+int hardEnumerate(const Dictionary* d, const HardConstraints* hc, uint32_t* out) {
+    // 需要相与的位图，最多 WORD_LENGTH 个位置 + MAX_ALPHABET 个计数
+    const uint64_t* sets[WORD_LENGTH + MAX_ALPHABET];
+    int nsets = 0;
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        if (hc->fixed[i] >= 0) sets[nsets++] = indexPosition(d, i, hc->fixed[i]);
+    }
+    for (int c = 0; c < MAX_ALPHABET; c++) {
+        int k = hc->min_count[c];
+        if (k > WORD_LENGTH || (k > 0 && c >= d->alphabet.size)) return 0;
+        if (k > 0) sets[nsets++] = indexAtLeast(d, c, k);
+    }
+
+    int blocks = d->index.blocks;
+    int found = 0;
+    for (int b = 0; b < blocks; b++) {
+        uint64_t v = ~0ull;
+        if (b == blocks - 1 && (d->count & 63)) v = (1ull << (d->count & 63)) - 1;
+        for (int k = 0; k < nsets && v; k++) v &= sets[k][b];
+        while (v) {
+            out[found++] = (uint32_t)(b * 64 + __builtin_ctzll(v));
+            v &= v - 1;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,17 @@
+#pragma once
+#include "dictionary.h"
+
+//困难模式约束：绿色字母固定位置，黄/绿字母必须出现
+struct HardConstraints {
+    int fixed[WORD_LENGTH];           // 固定字母，-1 表示不限
+    uint8_t min_count[MAX_ALPHABET];  // 每个字母至少出现的次数
+};
+
+//从已提交的各行（guesses 为 rows 个连续存放的单词）及其反馈收集约束。
+//与原规则一致，黄/绿字母只要求出现一次
+void hardCollect(HardConstraints* hc, const uint8_t* guesses, const uint8_t* patterns, int rows);
+
+int hardSatisfies(const HardConstraints* hc, const uint8_t* word);
+
+//用位图索引枚举所有满足约束的单词下标（升序）写入 out，out 至少 d->count 长，返回个数
+int hardEnumerate(const Dictionary* d, const HardConstraints* hc, uint32_t* out);
@@ -0,0 +1,249 @@
+#include "hint_search.h"
+#include "hardmode.h"
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+const HintLimits DEFAULT_LIMITS = { 3, 12, 5, 1 << 23 };
+const uint32_t HINT_POOL_NODES = 1 << 15;
+
+//到了深度上限的集合不再展开，按大小粗略估算：不会少于每个词都能一步分开的理想情况
+static float leafEstimate(int n) {
+    if (n <= 1) return 1.0f;
+    if (n == 2) return 1.5f;
+    float ideal = (2.0f * n - 1) / n;
+    float guess = 1.0f + 0.25f * log2f((float)n);
+    return guess > ideal ? guess : ideal;
+}
+
+static void freeTree(HintEngine* e, uint32_t node) {
+    while (node != POOL_NONE) {
+        SearchNode* sn = &e->pool.nodes[node];
+        uint32_t next = sn->sibling;
+        freeTree(e, sn->child);
+        poolFree(&e->pool, node);
+        node = next;
+    }
+}
+
+static uint32_t newNode(HintEngine* e, uint32_t guess, int count, float cost) {
+    uint32_t id = poolAlloc(&e->pool);
+    if (id == POOL_NONE) return POOL_NONE;
+    SearchNode* sn = &e->pool.nodes[id];
+    sn->guess = guess;
+    sn->count = (uint32_t)count;
+    sn->cost = cost;
+    sn->child = POOL_NONE;
+    sn->sibling = POOL_NONE;
+    sn->pattern = PATTERN_ALL_GREEN;
+    return id;
+}
+
+//可以提交的猜测词：普通模式为整个词库，困难模式为满足路径上所有约束的词
+static int guessPool(HintEngine* e, int depth, uint32_t* out) {
+    const Dictionary* d = e->d;
+    if (!e->hard_mode) {
+        for (int i = 0; i < d->count; i++) out[i] = (uint32_t)i;
+        return d->count;
+    }
+    HardConstraints hc;
+    hardCollect(&hc, e->guesses, e->patterns, e->rows + depth);
+    return hardEnumerate(d, &hc, out);
+}
+
+//在 cand[0..n) 上找期望次数最少的猜测。depth 为已经假设的步数；
+//bound 为父节点还能接受的上限，做不到时返回不小于 bound 的值且不留节点。*node 返回留下的子树
+static float searchSet(HintEngine* e, const uint32_t* cand, int n, int depth, float bound, uint32_t* node) {
+    *node = POOL_NONE;
+    if (n <= 2) {
+        float cost = n == 1 ? 1.0f : 1.5f;
+        if (cost < bound) *node = newNode(e, cand[0], n, cost);
+        return cost;
+    }
+    if (depth >= e->limits.max_depth) return leafEstimate(n);
+    // 每个词都能一步分开也达不到上限，不用再算
+    if ((2.0f * n - 1) / n >= bound) return bound;
+    // 剩下的打分次数连精算几个猜测词都不够时按大小估算；根节点总要给出一个词
+    int64_t left = e->limits.budget - e->stats.scored;
+    int width = depth == 0 ? e->limits.root_width : e->limits.width;
+    if (depth > 0 && left < (int64_t)width * n) return leafEstimate(n);
+
+    const Dictionary* d = e->d;
+    size_t mark = arenaMark(&e->arena);
+    uint32_t* pool = arenaArray<uint32_t>(&e->arena, d->count);
+    float* scores = arenaArray<float>(&e->arena, d->count);
+    uint32_t* order = arenaArray<uint32_t>(&e->arena, d->count);
+    int* freq = arenaArray<int>(&e->arena, d->count);
+    uint32_t* ids = arenaArray<uint32_t>(&e->arena, n);
+    uint8_t* patterns = arenaArray<uint8_t>(&e->arena, n);
+    uint32_t self = POOL_NONE;
+    if (pool && scores && order && freq && ids && patterns) self = newNode(e, HINT_NONE, n, 0);
+    if (self == POOL_NONE) {
+        // 内存预算用完，退化为估算
+        arenaRelease(&e->arena, mark);
+        return leafEstimate(n);
+    }
+    e->stats.expanded++;
+
+    // 这一层最多用掉剩余打分次数的一半，猜测词超出时先按字母频率留下得分高的，做法同熵策略
+    int pool_n = guessPool(e, depth, pool);
+    int64_t limit = left / 2 / n;
+    if (limit < width) limit = width;
+    if (pool_n > limit) {
+        frequencyScores(d, cand, n, pool, pool_n, freq);
+        for (int i = 0; i < pool_n; i++) order[i] = (uint32_t)i;
+        std::partial_sort(order, order + limit, order + pool_n, [&](uint32_t a, uint32_t b) {
+            return freq[a] > freq[b] || (freq[a] == freq[b] && a < b);
+        });
+        for (int i = 0; i < limit; i++) order[i] = pool[order[i]];
+        memcpy(pool, order, sizeof(uint32_t) * limit);
+        pool_n = (int)limit;
+    }
+    e->stats.scored += (int64_t)pool_n * n;
+
+    // 再按分组熵（sum c*log c 越小越好）给这些词排序，只精算前几个
+    int counts[PATTERN_COUNT];
+    for (int i = 0; i < pool_n; i++) {
+        scoreBatch(d, dictWord(d, pool[i]), cand, n, patterns);
+        countPatterns(patterns, n, counts);
+        float cost = 0;
+        for (int p = 0; p < PATTERN_COUNT; p++) {
+            if (counts[p] > 1) cost += counts[p] * logf((float)counts[p]);
+        }
+        // 同样好时优先本身可能是答案的词
+        if (counts[PATTERN_ALL_GREEN]) cost -= 1e-3f;
+        scores[i] = cost;
+        order[i] = (uint32_t)i;
+    }
+    if (width > pool_n) width = pool_n;
+    std::partial_sort(order, order + width, order + pool_n, [&](uint32_t a, uint32_t b) {
+        return scores[a] < scores[b] || (scores[a] == scores[b] && pool[a] < pool[b]);
+    });
+
+    float best = bound;
+    uint32_t best_guess = HINT_NONE;
+    uint32_t best_children = POOL_NONE;
+    int bucket_start[PATTERN_COUNT + 1];
+    uint8_t* row = e->guesses + (e->rows + depth) * WORD_LENGTH;
+    for (int k = 0; k < width; k++) {
+        uint32_t g = pool[order[k]];
+        const uint8_t* gw = dictWord(d, g);
+        partitionByPattern(d, gw, cand, n, patterns, ids, bucket_start);
+        e->stats.evaluated++;
+        e->stats.scored += n;
+
+        // 下界：每组都还要至少 (2m-1)/m 次
+        float lower = 1.0f;
+        for (int p = 0; p < PATTERN_COUNT; p++) {
+            int m = bucket_start[p + 1] - bucket_start[p];
+            if (p != PATTERN_ALL_GREEN && m > 0) lower += (2.0f * m - 1) / n;
+        }
+        if (lower >= best) continue;
+        int useless = 0;
+        for (int p = 0; p < PATTERN_COUNT; p++) {
+            if (p != PATTERN_ALL_GREEN && bucket_start[p + 1] - bucket_start[p] == n) useless = 1;
+        }
+        if (useless) continue;   // 完全分不开的猜测只会浪费一步
+
+        memcpy(row, gw, WORD_LENGTH);
+        float cost = 1.0f;
+        float rest = lower - 1.0f;  // 还没算的组的下界之和
+        uint32_t children = POOL_NONE;
+        for (int p = 0; p < PATTERN_COUNT && cost + rest < best; p++) {
+            int m = bucket_start[p + 1] - bucket_start[p];
+            if (p == PATTERN_ALL_GREEN || m == 0) continue;
+            rest -= (2.0f * m - 1) / n;
+            e->patterns[e->rows + depth] = (uint8_t)p;
+            uint32_t child;
+            float c = searchSet(e, ids + bucket_start[p], m, depth + 1,
+                                (best - cost - rest) * n / m, &child);
+            cost += c * m / n;
+            if (child != POOL_NONE) {
+                e->pool.nodes[child].pattern = (uint8_t)p;
+                e->pool.nodes[child].sibling = children;
+                children = child;
+            }
+        }
+        if (cost + rest < best && cost < best) {
+            freeTree(e, best_children);
+            best = cost;
+            best_guess = g;
+            best_children = children;
+            if (best <= (2.0f * n - 1) / n + 1e-6f) break;   // 已经是理想情况
+        } else {
+            freeTree(e, children);
+        }
+    }
+    arenaRelease(&e->arena, mark);
+
+    if (best_guess == HINT_NONE) {
+        poolFree(&e->pool, self);
+        return best;
+    }
+    SearchNode* sn = &e->pool.nodes[self];
+    sn->guess = best_guess;
+    sn->cost = best;
+    sn->child = best_children;
+    *node = self;
+    return best;
+}
+
+void hintInit(HintEngine* e, const Dictionary* d) {
+    e->d = d;
+    if (e->pool.nodes.empty()) {
+        e->limits = DEFAULT_LIMITS;
+        poolInit(&e->pool, HINT_POOL_NODES);
+        e->root = POOL_NONE;
+    }
+    if (e->arena.buf.empty() || e->count != d->count || e->dict_hash != d->hash) {
+        // 每层最多：猜测词表、两种分数、排序各 count 个，再加本层候选的分组结果
+        size_t level = (size_t)d->count * (4 * sizeof(uint32_t) + sizeof(uint32_t) + 1) + 64;
+        arenaInit(&e->arena, level * (HINT_MAX_DEPTH + 1));
+        e->dict_hash = d->hash;
+        e->count = d->count;
+    }
+}
+
+uint32_t hintSearch(HintEngine* e, const SolverState* s, float* expected) {
+    const Dictionary* d = s->d;
+    hintInit(e, d);
+    if (e->limits.max_depth > HINT_MAX_DEPTH) e->limits.max_depth = HINT_MAX_DEPTH;
+    poolClear(&e->pool);
+    e->root = POOL_NONE;
+    arenaRelease(&e->arena, 0);
+    arenaResetPeak(&e->arena);
+    memset(&e->stats, 0, sizeof(e->stats));
+
+    e->hard_mode = s->hard_mode;
+    if (s->attempt > MAX_GUESSES) return HINT_NONE;
+    e->rows = s->attempt;
+    memcpy(e->guesses, s->guesses, (size_t)s->attempt * WORD_LENGTH);
+    memcpy(e->patterns, s->patterns, s->attempt);
+
+    // 没给候选时保留与各行反馈都一致的词
+    const uint32_t* cand = s->candidates;
+    int n = s->candidate_count;
+    if (!cand) {
+        uint32_t* all = arenaArray<uint32_t>(&e->arena, d->count);
+        n = 0;
+        for (int i = 0; i < d->count; i++) {
+            const uint8_t* w = dictWord(d, i);
+            int ok = 1;
+            for (int r = 0; r < s->attempt && ok; r++) {
+                ok = scorePattern(s->guesses + r * WORD_LENGTH, w) == s->patterns[r];
+            }
+            if (ok) all[n++] = (uint32_t)i;
+        }
+        cand = all;
+    }
+    if (n == 0) return HINT_NONE;
+
+    float cost = searchSet(e, cand, n, 0, FLT_MAX, &e->root);
+    uint32_t guess = e->root != POOL_NONE ? e->pool.nodes[e->root].guess : cand[0];
+    e->stats.node_peak = e->pool.peak;
+    e->stats.tree_nodes = e->pool.live;
+    e->stats.arena_peak = e->arena.peak;
+    if (expected) *expected = cost;
+    return guess;
+}
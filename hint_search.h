@@ -0,0 +1,62 @@
+#pragma once
+#include "dictionary.h"
+#include "scoring.h"
+#include "solver.h"
+#include "arena.h"
+
+const uint32_t HINT_NONE = 0xFFFFFFFFu;
+const int HINT_MAX_DEPTH = 4;
+
+//提示搜索：在候选集合上向前看几步，找期望猜测次数最少的下一步。
+//每层的候选数组、分组结果都从 arena 上按层分配、退出时整层退回，搜索树节点来自定长节点池，
+//词库不变时整次搜索不调用 malloc。打分总次数有上限，词库再大、候选再多，一次提示的耗时也有界
+
+//搜索树节点：一个候选集合和对它的最佳猜测，子节点是这个猜测得到各种反馈后剩下的集合
+struct SearchNode {
+    uint32_t guess;
+    uint32_t count;     // 集合中的候选词个数
+    float cost;         // 从这里起期望还要猜几次（含这一次）
+    uint32_t child;     // 第一个子节点，POOL_NONE 表示没有展开
+    uint32_t sibling;
+    uint8_t pattern;    // 父节点的猜测得到的反馈
+};
+
+struct HintLimits {
+    int max_depth;      // 展开几步猜测（不超过 HINT_MAX_DEPTH），更深的集合按大小估算
+    int root_width;     // 根节点精算几个猜测词（先按分组熵预选）
+    int width;          // 其它节点精算几个
+    int64_t budget;     // 每次搜索最多打几次分（猜测词 × 候选词），用完后剩下的集合按大小估算
+};
+
+//每次搜索的开销
+struct HintStats {
+    uint32_t expanded;      // 展开的候选集合数
+    uint32_t evaluated;     // 精算的（集合，猜测）对数
+    int64_t scored;         // 打分次数
+    uint32_t node_peak;     // 搜索树同时占用的最多节点数
+    uint32_t tree_nodes;    // 最后留下的策略树节点数
+    size_t arena_peak;      // 临时数组用到的最多字节数
+};
+
+struct HintEngine {
+    uint64_t dict_hash;
+    int count;
+    const Dictionary* d;
+    Arena arena;
+    NodePool<SearchNode> pool;
+    HintLimits limits;
+    uint32_t root;          // 上一次搜索留下的策略树
+    HintStats stats;
+    // 搜索路径：真实的各行加上假设的各行，困难模式按它收集约束
+    int hard_mode;
+    int rows;
+    uint8_t guesses[(MAX_GUESSES + HINT_MAX_DEPTH) * WORD_LENGTH];
+    uint8_t patterns[MAX_GUESSES + HINT_MAX_DEPTH];
+};
+
+//按词库大小准备 arena 与节点池，词库不变时不重新申请
+void hintInit(HintEngine* e, const Dictionary* d);
+
+//s->candidates 为空时由各行反馈从整个词库推出候选。
+//返回建议的词下标，没有候选时返回 HINT_NONE；expected 可为空，否则写入期望还要猜的次数（含这一次）
+uint32_t hintSearch(HintEngine* e, const SolverState* s, float* expected);
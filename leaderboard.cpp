@@ -0,0 +1,197 @@
+#include "leaderboard.h"
+
+void leaderboardInit(Leaderboard* lb) {
+    lb->nodes.clear();
+    lb->free_nodes.clear();
+    lb->by_player.clear();
+    lb->root = TREAP_NONE;
+    lb->seed = 0x9E3779B9u;
+}
+
+static uint32_t sizeOf(const Leaderboard* lb, uint32_t n) {
+    return n == TREAP_NONE ? 0 : lb->nodes[n].size;
+}
+
+static void pull(Leaderboard* lb, uint32_t n) {
+    TreapNode& t = lb->nodes[n];
+    t.size = 1 + sizeOf(lb, t.left) + sizeOf(lb, t.right);
+}
+
+//a 是否排在 b 前面
+static bool before(int64_t score_a, uint64_t id_a, int64_t score_b, uint64_t id_b) {
+    if (score_a != score_b) return score_a > score_b;
+    return id_a < id_b;
+}
+
+//按 (score, id) 把树分成排在它前面的部分 l 和其余部分 r
+static void split(Leaderboard* lb, uint32_t n, int64_t score, uint64_t id, uint32_t* l, uint32_t* r) {
+    if (n == TREAP_NONE) {
+        *l = *r = TREAP_NONE;
+        return;
+    }
+    TreapNode& t = lb->nodes[n];
+    if (before(t.score, t.player_id, score, id)) {
+        split(lb, t.right, score, id, &lb->nodes[n].right, r);
+        *l = n;
+    } else {
+        split(lb, t.left, score, id, l, &lb->nodes[n].left);
+        *r = n;
+    }
+    pull(lb, n);
+}
+
+static uint32_t merge(Leaderboard* lb, uint32_t a, uint32_t b) {
+    if (a == TREAP_NONE) return b;
+    if (b == TREAP_NONE) return a;
+    if (lb->nodes[a].priority > lb->nodes[b].priority) {
+        lb->nodes[a].right = merge(lb, lb->nodes[a].right, b);
+        pull(lb, a);
+        return a;
+    }
+    lb->nodes[b].left = merge(lb, a, lb->nodes[b].left);
+    pull(lb, b);
+    return b;
+}
+
+static uint32_t allocNode(Leaderboard* lb, uint64_t id, int64_t score) {
+    uint32_t n;
+    if (!lb->free_nodes.empty()) {
+        n = lb->free_nodes.back();
+        lb->free_nodes.pop_back();
+    } else {
+        n = (uint32_t)lb->nodes.size();
+        lb->nodes.emplace_back();
+    }
+    // xorshift32
+    lb->seed ^= lb->seed << 13;
+    lb->seed ^= lb->seed >> 17;
+    lb->seed ^= lb->seed << 5;
+    lb->nodes[n] = { score, id, lb->seed, 1, TREAP_NONE, TREAP_NONE };
+    return n;
+}
+
+//从以 n 为根的子树中删掉结点 target，返回新的子树根
+static uint32_t erase(Leaderboard* lb, uint32_t n, uint32_t target) {
+    if (n == target) {
+        lb->free_nodes.push_back(n);
+        return merge(lb, lb->nodes[n].left, lb->nodes[n].right);
+    }
+    const TreapNode& x = lb->nodes[target];
+    TreapNode& t = lb->nodes[n];
+    if (before(x.score, x.player_id, t.score, t.player_id)) {
+        t.left = erase(lb, t.left, target);
+    } else {
+        t.right = erase(lb, t.right, target);
+    }
+    pull(lb, n);
+    return n;
+}
+
+void leaderboardUpdate(Leaderboard* lb, uint64_t player_id, int present, int64_t score) {
+    auto it = lb->by_player.find(player_id);
+    if (it != lb->by_player.end()) {
+        if (present && lb->nodes[it->second].score == score) return;
+        lb->root = erase(lb, lb->root, it->second);
+        lb->by_player.erase(it);
+    }
+    if (!present) return;
+    uint32_t n = allocNode(lb, player_id, score);
+    uint32_t l, r;
+    split(lb, lb->root, score, player_id, &l, &r);
+    lb->root = merge(lb, merge(lb, l, n), r);
+    lb->by_player[player_id] = n;
+}
+
+int leaderboardSize(const Leaderboard* lb) {
+    return (int)sizeOf(lb, lb->root);
+}
+
+int leaderboardRank(const Leaderboard* lb, uint64_t player_id) {
+    auto it = lb->by_player.find(player_id);
+    if (it == lb->by_player.end()) return 0;
+    const TreapNode& target = lb->nodes[it->second];
+    int rank = 0;
+    uint32_t n = lb->root;
+    while (n != it->second) {
+        const TreapNode& t = lb->nodes[n];
+        if (before(target.score, target.player_id, t.score, t.player_id)) {
+            n = t.left;
+        } else {
+            rank += (int)sizeOf(lb, t.left) + 1;
+            n = t.right;
+        }
+    }
+    return rank + (int)sizeOf(lb, lb->nodes[n].left) + 1;
+}
+
+//中序遍历，跳过整棵不需要的子树
+static void collect(const Leaderboard* lb, uint32_t n, int skip, int k, RankEntry* out, int* got) {
+    while (n != TREAP_NONE && *got < k) {
+        const TreapNode& t = lb->nodes[n];
+        int left = (int)sizeOf(lb, t.left);
+        if (skip < left) {
+            collect(lb, t.left, skip, k, out, got);
+            skip = 0;
+        } else {
+            skip -= left;
+        }
+        if (*got >= k) return;
+        if (skip == 0) {
+            out[(*got)++] = { t.player_id, t.score };
+        } else {
+            skip--;
+        }
+        n = t.right;
+    }
+}
+
+int leaderboardPage(const Leaderboard* lb, int start, int k, RankEntry* out) {
+    int got = 0;
+    if (start < 1 || k <= 0) return 0;
+    collect(lb, lb->root, start - 1, k, out, &got);
+    return got;
+}
+
+int64_t leaderboardScore(const Statistics* s, int board, int* present) {
+    switch (board) {
+        case BOARD_WIN_RATE:
+            *present = s->games_played > 0;
+            return *present ? (int64_t)s->games_won * 10000 / s->games_played : 0;
+        case BOARD_MAX_STREAK:
+            *present = s->games_played > 0;
+            return s->max_streak;
+        case BOARD_AVG_GUESSES: {
+            int64_t won = 0, sum = 0;
+            for (int i = 0; i < MAX_ATTEMPTS; i++) {
+                won += s->guess_distribution[i];
+                sum += (int64_t)s->guess_distribution[i] * (i + 1);
+            }
+            *present = won > 0;
+            return *present ? -(sum * 1000 / won) : 0;
+        }
+    }
+    *present = 0;
+    return 0;
+}
+
+void leaderboardsInit(Leaderboards* lbs) {
+    for (int b = 0; b < BOARD_COUNT; b++) leaderboardInit(&lbs->boards[b]);
+}
+
+void leaderboardsUpdate(Leaderboards* lbs, uint64_t player_id, const Statistics* s) {
+    for (int b = 0; b < BOARD_COUNT; b++) {
+        int present;
+        int64_t score = leaderboardScore(s, b, &present);
+        leaderboardUpdate(&lbs->boards[b], player_id, present, score);
+    }
+}
+
+void leaderboardsBuild(Leaderboards* lbs, PlayerStatsStore* store) {
+    playerStatsForEach(store, [&](PlayerStats* p) {
+        uint64_t id = p->player_id.load(std::memory_order_acquire);
+        Statistics s;
+        playerStatsSnapshot(store, id, &s);
+        leaderboardsUpdate(lbs, id, &s);
+        return 1;
+    });
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+#include "player_stats.h"
+
+//排行榜种类
+enum { BOARD_WIN_RATE, BOARD_MAX_STREAK, BOARD_AVG_GUESSES, BOARD_COUNT };
+
+const uint32_t TREAP_NONE = 0xFFFFFFFFu;
+
+//带子树大小的 treap 结点，按 (score 降序, player_id 升序) 排列，第 1 名在最左边
+struct TreapNode {
+    int64_t score;
+    uint64_t player_id;
+    uint32_t priority;
+    uint32_t size;
+    uint32_t left, right;
+};
+
+struct RankEntry {
+    uint64_t player_id;
+    int64_t score;
+};
+
+//一个排行榜：结点放在池里按下标引用，删除的结点进空闲链表复用。
+//只在记录对局的线程里更新，排名、第 k 名、翻页都是 O(log n)
+struct Leaderboard {
+    std::vector<TreapNode> nodes;
+    std::vector<uint32_t> free_nodes;
+    uint32_t root;
+    uint32_t seed;
+    std::unordered_map<uint64_t, uint32_t> by_player;  // 玩家当前在榜上的结点
+};
+
+struct Leaderboards {
+    Leaderboard boards[BOARD_COUNT];
+};
+
+void leaderboardInit(Leaderboard* lb);
+//更新玩家的分数，present 为 0 时把玩家从榜上移除
+void leaderboardUpdate(Leaderboard* lb, uint64_t player_id, int present, int64_t score);
+int leaderboardSize(const Leaderboard* lb);
+//玩家名次（从 1 开始），不在榜上返回 0
+int leaderboardRank(const Leaderboard* lb, uint64_t player_id);
+//从第 start 名（从 1 开始）起取最多 k 名写入 out，返回实际个数
+int leaderboardPage(const Leaderboard* lb, int start, int k, RankEntry* out);
+
+//由统计数据计算某个榜的分数，越大越靠前；不该上榜（如还没赢过，没有平均次数）时 present 为 0。
+//胜率以万分之一为单位，平均猜测次数取负的千分之一
+int64_t leaderboardScore(const Statistics* s, int board, int* present);
+void leaderboardsInit(Leaderboards* lbs);
+void leaderboardsUpdate(Leaderboards* lbs, uint64_t player_id, const Statistics* s);
+//把统计库里已有的所有玩家放上榜（启动时调用一次）
+void leaderboardsBuild(Leaderboards* lbs, PlayerStatsStore* store);
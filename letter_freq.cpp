@@ -0,0 +1,62 @@
+#include "letter_freq.h"
+#include <string.h>
+
+void freqFromDict(LetterFreq* f, const Dictionary* d) {
+    f->count = d->count;
+    memcpy(f->pos, d->pos_freq, sizeof(f->pos));
+    memcpy(f->any, d->letter_freq, sizeof(f->any));
+}
+
+void freqFromWords(LetterFreq* f, const Dictionary* d, const uint32_t* ids, int n) {
+    memset(f, 0, sizeof(*f));
+    f->count = n;
+    for (int i = 0; i < n; i++) {
+        const uint8_t* w = dictWord(d, ids[i]);
+        uint64_t seen = 0;
+        for (int p = 0; p < WORD_LENGTH; p++) {
+            f->pos[p][w[p]]++;
+            if (!(seen & (1ull << w[p]))) f->any[w[p]]++;
+            seen |= 1ull << w[p];
+        }
+    }
+}
+
+void freqRemove(LetterFreq* f, const uint8_t* word) {
+    uint64_t seen = 0;
+    for (int p = 0; p < WORD_LENGTH; p++) {
+        f->pos[p][word[p]]--;
+        if (!(seen & (1ull << word[p]))) f->any[word[p]]--;
+        seen |= 1ull << word[p];
+    }
+    f->count--;
+}
+
+void freqRemoveWords(LetterFreq* f, const Dictionary* d, const uint32_t* ids, int n) {
+    for (int i = 0; i < n; i++) freqRemove(f, dictWord(d, ids[i]));
+}
+
+int freqFilter(LetterFreq* f, const Dictionary* d, uint32_t* cand, int n, const uint8_t* guess, uint8_t pattern) {
+    // 分段打分，避免为整个候选集合分配反馈数组
+    uint8_t tmp[256];
+    int kept = 0;
+    for (int base = 0; base < n; base += (int)sizeof(tmp)) {
+        int len = n - base < (int)sizeof(tmp) ? n - base : (int)sizeof(tmp);
+        scoreBatch(d, guess, cand + base, len, tmp);
+        for (int i = 0; i < len; i++) {
+            uint32_t w = cand[base + i];
+            if (tmp[i] == pattern) cand[kept++] = w;
+            else freqRemove(f, dictWord(d, w));
+        }
+    }
+    return kept;
+}
+
+int freqTopAt(const LetterFreq* f, int p, int alphabet_size, float* share) {
+    if (f->count <= 0) return -1;
+    int best = 0;
+    for (int c = 1; c < alphabet_size; c++) {
+        if (f->pos[p][c] > f->pos[p][best]) best = c;
+    }
+    *share = (float)f->pos[p][best] / f->count;
+    return best;
+}
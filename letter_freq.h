@@ -0,0 +1,25 @@
+#pragma once
+#include "dictionary.h"
+#include "scoring.h"
+
+//候选词的字母频率表：开局时直接取词库预先算好的整表，之后每次反馈只把被淘汰的词减掉，
+//更新的开销与淘汰的词数成正比，不随词库大小增长。键盘热度和提示里的字母建议都从这里读
+struct LetterFreq {
+    int count;                                  // 候选词数
+    uint32_t pos[WORD_LENGTH][MAX_ALPHABET];    // 第 p 位是字母 c 的候选数
+    uint32_t any[MAX_ALPHABET];                 // 含有字母 c 的候选数（重复的字母只算一次）
+};
+
+//所有词都是候选
+void freqFromDict(LetterFreq* f, const Dictionary* d);
+//按给定的一组词现数（候选不是整个词库时）
+void freqFromWords(LetterFreq* f, const Dictionary* d, const uint32_t* ids, int n);
+//把一个词从表里减掉
+void freqRemove(LetterFreq* f, const uint8_t* word);
+//把一组词都从表里减掉
+void freqRemoveWords(LetterFreq* f, const Dictionary* d, const uint32_t* ids, int n);
+//按一次反馈筛候选：保留的词按原顺序留在 cand 前面，淘汰的词从表里减掉，返回剩下的个数
+int freqFilter(LetterFreq* f, const Dictionary* d, uint32_t* cand, int n, const uint8_t* guess, uint8_t pattern);
+
+//第 p 位最常见的字母，写入它占候选的比例（0..1）；没有候选时返回 -1
+int freqTopAt(const LetterFreq* f, int p, int alphabet_size, float* share);
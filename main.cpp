@@ -4,6 +4,27 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "dictionary.h"
+#include "scoring.h"
+#include "hardmode.h"
+#include "letter_freq.h"
+#include "player_stats.h"
+#include "game_archive.h"
+#include "leaderboard.h"
+#include "opening_book.h"
+#include "hint_search.h"
+#include "daily.h"
+#include "scene.h"
+#include "animation.h"
+#include "spsc.h"
+#include "telemetry.h"
+#include "words_table.h"
 
 //颜色定义
 #define GREEN      RGB(106, 170, 100)
@@ -14,30 +35,49 @@
 
 const int SCREEN_WIDTH = 1000;
 const int SCREEN_HEIGHT = 720;
-const int WORD_LENGTH = 5;
-const int MAX_ATTEMPTS = 6;
 const int CELL_SIZE = 60;
+const int COMPLETIONS_SHOWN = 3;    // 当前前缀能拼出的词不超过这么多时，在输入行下方直接列出
 
 //游戏状态
-enum { PAGE_MAIN_MENU, PAGE_GAME, PAGE_HELP, PAGE_STATS, PAGE_EXIT } current_page = PAGE_MAIN_MENU;
+enum { PAGE_MAIN_MENU, PAGE_GAME, PAGE_HELP, PAGE_STATS, PAGE_EXIT };
+int current_page = PAGE_MAIN_MENU;  // 逻辑线程独占，其它线程看快照里的 page
+
+//游戏模式
+enum { MODE_CLASSIC, MODE_ABSURDLE, MODE_MULTI, MODE_DAILY };
 
 //基础游戏结构
 struct Game {
-    char target_word[6];
-    char guesses[MAX_ATTEMPTS][6];
+    int mode;
+    int board_count;                            // 同时猜的词数，经典/对抗模式为 1
+    int max_attempts;
+    char target_word[MAX_BOARDS][WORD_TEXT_MAX]; // UTF-8 文本，对抗模式下只在对局结束时确定
+    uint32_t target_ids[MAX_BOARDS];
+    uint8_t guesses[MAX_GUESSES][WORD_LENGTH];  // 各行的字母编号
+    int typed;                                  // 当前行已输入的字母数
+    uint8_t patterns[MAX_BOARDS][MAX_GUESSES];  // 已提交各行在每个盘面上的反馈
+    int solved_at[MAX_BOARDS];                  // 在第几行猜中，-1 表示尚未猜中
     int current_attempt;
     int game_over;
     int won;
     int invalid_word;
     int hint_used;
     char hint_message[100];
+    char hint_word[WORD_TEXT_MAX + 2];      // 接在提示后面显示的单词或字母（UTF-8）
+    char hint_detail[64];                   // 提示下方的小字：这次搜索的开销
+    int8_t hint_letters[WORD_LENGTH];       // 提示时各位置在候选中最常见的字母，-1 表示没有
+    uint8_t hint_shares[WORD_LENGTH];       // 以及它在候选中的占比（百分数）
+    int candidate_count;                    // 单盘面对局：与所有反馈一致的词数
+    uint8_t key_heat[MAX_ALPHABET];         // 单盘面对局：含这个字母的候选占比（0..255），热度键盘用
     int hard_mode;
-    int key_status[26]; // 键盘状态：0=未用, 1=灰, 2=黄, 3=绿
+    int key_status[MAX_BOARDS][MAX_ALPHABET]; // 每个盘面的键盘状态：0=未用, 1=灰, 2=黄, 3=绿
+    uint32_t prefix_nodes[WORD_LENGTH + 1]; // 当前行每个前缀在 DAWG 中的节点，DAWG_NONE 表示词库中无此前缀
+    char completions[COMPLETIONS_SHOWN * WORD_TEXT_MAX]; // 当前前缀能拼出的词（UTF-8，空格隔开），多于 COMPLETIONS_SHOWN 个时为空
+    int hard_legal_count;                   // 困难模式：当前约束下可以提交的单词数
+    DictSnapshot dict;                      // 本局开始时的词库快照，词库热更新不影响进行中的对局
 } game;
 
-//开足够大的二维数组保存词库
-char word_list[1000][6];
-int word_count = 0;
+//词库文件，修改后自动重新加载
+const char* WORDS_FILE = "words.txt";
 
 //按钮结构
 struct Button {
@@ -46,21 +86,103 @@ struct Button {
     int page_id;
 };
 
-Button mainButtons[5];
-Button backBtn;
-
-//统计数据结构
-struct Statistics {
-    int games_played;
-    int games_won;
-    int current_streak;
-    int max_streak;
-    int guess_distribution[MAX_ATTEMPTS];
+//主菜单按钮：左列开始游戏，右列其它页面；文字为空的按钮随菜单设置变化（见 mainButtonText）
+const int MAIN_BUTTON_COUNT = 12;
+const Button mainButtons[MAIN_BUTTON_COUNT] = {
+    { 260, 200, 230, 50, "简单模式", PAGE_GAME },
+    { 510, 200, 230, 50, "游戏说明", PAGE_HELP },
+    { 510, 270, 230, 50, "统计数据", PAGE_STATS },
+    { 510, 340, 230, 50, "退出游戏", PAGE_EXIT },
+    { 260, 270, 230, 50, "困难模式", PAGE_GAME },
+    { 260, 340, 230, 50, "对抗模式", PAGE_GAME },
+    { 260, 480, 230, 50, nullptr, PAGE_MAIN_MENU },
+    { 260, 410, 230, 50, "多词模式", PAGE_GAME },
+    { 510, 410, 230, 50, nullptr, PAGE_MAIN_MENU },
+    { 510, 480, 230, 50, nullptr, PAGE_MAIN_MENU },
+    { 260, 550, 230, 50, "每日一题", PAGE_GAME },
+    { 510, 550, 230, 50, nullptr, PAGE_MAIN_MENU },
 };
-
+int menu_hard_mode = 0;   // 对抗模式是否使用困难规则
+int menu_board_count = 4; // 多词模式的词数：2/4/8/16
+int menu_no_repeat = 0;   // 本次运行内不重复出题
+int menu_heat = 0;        // 键盘按候选中的字母频率着色
+
+//出题：按词库的权重抽样，打开“不重复”时用 target_sampler 做不放回抽样
+uint64_t rng_state = 0;
+SessionSampler target_sampler = {};
+
+//界面场景（绘制线程独占）：每个布局（页面或一局）的控件布局一次，之后只重画变化的区域
+Scene scene;
+uint64_t scene_layout = 0;  // 场景按哪个布局编号建的，0 表示还没建
+
+//场景中标签、面板与按钮的编号（主菜单按钮的编号就是它在 mainButtons 中的下标）
+enum { UI_BACKDROP, UI_DICT_INFO, UI_TITLE, UI_HARD_LEGAL, UI_TYPING, UI_HINT_BOX, UI_GAME_OVER, UI_STATS, UI_STATS_INFO,
+       UI_HINT_LETTERS };
+enum { BTN_BACK = 100, BTN_HINT, BTN_DEL, BTN_STATS_RANGE, BTN_STATS_MODE };
+
+//动画（绘制线程独占）：游戏状态立即更新，动画只按时间改变显示；没有动画时主循环降到低频轮询
+Animator animator;
+uint32_t frame_time = 0;                // 本帧的时间，绘制时按它采样动画
+const uint32_t FRAME_MS = 16;           // 有动画时的帧间隔
+const uint32_t IDLE_FRAME_MS = 40;      // 没有动画时的轮询间隔
+const uint32_t FLIP_MS = 500, FLIP_STAGGER_MS = 250;
+const uint32_t SHAKE_MS = 400;
+const uint32_t BOUNCE_MS = 500, BOUNCE_STAGGER_MS = 100;
+const int SHAKE_PX = 8, BOUNCE_PX = 20;
+
+//每日一题排期（wordle_daily 生成），第一次进入每日一题或词库变化后读取
+DailySchedule daily_schedule;
+int daily_loaded = 0;
+const char* DAILY_FILE = "daily.bin";
+
+//开局库，普通/困难模式各一份，第一次需要时读取或生成
+OpeningBook opening_books[2];
+int opening_loaded[2] = {0, 0};
+
+//对局中的大数组不放进 Game，快照只带数量，发布快照时不用复制（逻辑线程独占）
+std::vector<uint32_t> hard_legal;           // 困难模式：当前约束下所有可以提交的单词
+
+//候选跟踪（逻辑线程独占）：单盘面对局中与所有反馈一致的词，以及它们的字母频率表。
+//每次提交只把淘汰的词从表里减掉，键盘热度与提示里的字母建议都从表里直接读。
+//对抗模式的回应也在这份候选上分组，分组时顺便减掉被淘汰的组，不再另外筛一遍
+std::vector<uint32_t> tracked_candidates;
+LetterFreq letter_freq;
+
+//提示搜索（逻辑线程独占），内存在第一次提示时按词库大小申请，之后重复使用
+HintEngine hint_engine;
+
+//对局事件广播到共享内存（tools/wordle_spectate 观战），打不开时游戏照常运行
+TelemetryRing telemetry;
+uint64_t session_id = 0;
+
+//统计数据：所有玩家存在 players 里，stats 是当前玩家的一份副本，供统计页面显示
+PlayerStatsStore players;
+uint64_t local_player_id = 0;
+char local_player_name[64] = "玩家";
 Statistics stats = {0};
-
-// 屏幕键盘布局
+Leaderboards leaderboards;
+const int LEADERBOARD_TOP = 3;  // 统计页面每个榜显示前几名
+const char* PLAYERS_FILE = "players.dat";
+
+//对局档案：每局单盘面对局结束后追加一条，统计页面按时间/模式筛选时从档案现算
+GameArchive archive;
+const char* ARCHIVE_FILE = "games.warc";
+const char* STATS_RANGE_NAMES[] = { "全部时间", "近 7 天", "近 30 天" };
+const int STATS_RANGE_DAYS[] = { 0, 7, 30 };
+const char* STATS_MODE_NAMES[] = { "全部模式", "经典", "困难", "每日一题", "对抗" };
+const int STATS_RANGE_COUNT = 3, STATS_MODE_COUNT = 5;
+
+//统计页面的筛选与结果（逻辑线程计算，随快照交给绘制线程）
+struct StatsView {
+    int range, mode;            // STATS_RANGE_NAMES / STATS_MODE_NAMES 的下标
+    Statistics filtered;        // 有筛选时的统计，不筛选时直接显示 stats
+    char opener[WORD_TEXT_MAX]; // 筛选范围内最常用的开局词，没有时为空
+    int opener_count;
+    uint64_t archived;          // 档案中的总局数
+    float elapsed_ms;           // 这次扫描档案用的时间
+} stats_view;
+
+// 屏幕键盘布局：英文字母按 QWERTY 排列，字母表里的其它符号按编号顺序排在后面
 const char* keyboard_rows[3] = {
     "QWERTYUIOP",
     "ASDFGHJKL",
@@ -70,72 +192,164 @@ const int row_lengths[3] = {10, 9, 7};
 
 struct Key {
     int x, y, w, h;
-    char ch;
-} keys[26];
+    int used;   // 0 表示当前字母表没有这个键
+} keys[MAX_ALPHABET];
+
+//线程划分：输入线程只收消息、做点击检测；逻辑线程独占 game、菜单设置与统计（提示计算、存盘都在这里）；
+//主线程只按最新的界面快照绘制。输入 -> 逻辑、逻辑 -> 绘制各有一条无锁队列；状态做成不可变快照，
+//经过各自的三缓冲槽交给另外两个线程（std::atomic<std::shared_ptr> 在 libstdc++/MSVC 里是加锁实现，不用它）
+enum { CMD_CLICK, CMD_CHAR, CMD_KEY };
+struct Command {
+    int type;
+    int kind;           // CMD_CLICK：被点中的控件种类
+    int id;             // CMD_CLICK：控件编号；CMD_CHAR：字符；CMD_KEY：虚拟键码
+    uint64_t layout;    // CMD_CLICK：点击时看到的布局，逻辑线程已换布局时作废
+};
+
+//动画事件：逻辑线程只说明哪一行要动，按什么区域、怎么画由绘制线程决定
+enum { FX_REVEAL, FX_SHAKE, FX_BOUNCE };
+struct Effect {
+    int kind;
+    uint64_t layout;    // 所属布局，布局已经换掉的事件直接丢弃
+    int board, row;
+    uint32_t time;      // 发生时间（GetTickCount）
+};
+
+//快照里的排行榜：当前玩家的名次与前几名
+struct RankView {
+    int rank, size, count;
+    RankEntry top[LEADERBOARD_TOP];
+};
+
+//界面快照：逻辑线程处理完一批命令后发布一份，发布后不再修改
+struct GameView {
+    uint64_t layout;    // 布局编号：换页面或开新局时增加
+    int page;
+    Game game;
+    Key keys[MAX_ALPHABET];
+    int menu_hard_mode, menu_board_count, menu_no_repeat, menu_heat;
+    Statistics stats;
+    StatsView stats_view;
+    RankView ranks[BOARD_COUNT];
+};
+typedef std::shared_ptr<const GameView> ViewSnapshot;
+
+SpscQueue<Command, 256> input_queue;
+SpscQueue<Effect, 256> effect_queue;
+SpscLatest<ViewSnapshot> render_view;   // 逻辑 -> 绘制
+SpscLatest<ViewSnapshot> input_view;    // 逻辑 -> 输入（点击检测按最新的布局）
+uint64_t layout_id = 1;                 // 逻辑线程当前的布局编号
+std::vector<Effect> pending_effects;    // 本批命令产生的动画事件，快照发布之后再送出
 
 // 函数声明
 //工具函数
 void initGraphics();
-int randInt(int max);
+uint32_t pickTarget(const Dictionary* d);
+uint32_t dailyTarget(const Dictionary* d);
 void loadWordList();
+void startDictWatcher();
 void saveStats();
 void loadStats();
 void updateStats();
-void startNewGame(int hard_mode);
-int isValidWord(const char* word);
-int satisfiesHardMode(const char* guess);
-void checkGuess(char* guess, int* result);
+void archiveGame();
+void refreshStatsView();
+void startNewGame(int hard_mode, int mode, int board_count);
+int isValidWord(const uint8_t* word);
+int satisfiesHardMode(const uint8_t* guess);
+void collectHardConstraints(HardConstraints* hc);
+void submitGuess();
+uint8_t absurdleRespond(const uint8_t* guess);
 void provideHint();
-void updateKeyboardStatus();
-void initKeyboardLayout();
-
-//绘图函数
-void drawKeyboard();
-void drawCell(int x, int y, int size, char c, int color);
-void drawMainMenu();
-void drawGameScreen();
-void drawHelpScreen();
-void drawStatsScreen();
+uint32_t openingSuggest();
+void updateKeyboardStatus(int row);
+void resetCandidates();
+void filterCandidates(int row);
+void initKeyboardLayout(const Alphabet* a);
+void appendLetter(int sym);
+void removeLetter();
+void updateCompletions();
+int charToSymbol(unsigned char c);
+
+//绘图函数（只读快照）
+void drawKey(const GameView* v, int sym);
+void outUtf8(int x, int y, const char* text);
+int utf8Width(const char* text);
+void drawCell(const GameView* v, int x, int y, int size, int sym, int color);
+void drawCellHeight(const GameView* v, int x, int y, int size, int height, int sym, int color);
+void drawAnimatedCell(const GameView* v, const Widget* w);
+void cellState(const GameView* v, int board, int row, int col, int* sym, int* color);
+void boardLayout(const GameView* v, int board, int* x0, int* y0, int* cell, int* row_step);
+int typingMessage(const GameView* v, char* buf, COLORREF* color);
+const char* mainButtonText(const GameView* v, int i);
+void drawBackdrop(const GameView* v);
+void drawStatsBody(const GameView* v);
+void drawGameOver(const GameView* v);
+void drawButton(const GameView* v, const Widget* w);
+void drawLabel(const GameView* v, const Widget* w);
+void drawLeaderboards(const GameView* v, int x, int y);
+
+//界面场景
+void buildScene(Scene* s, const GameView* v);
+uint64_t widgetLook(const GameView* v, const Widget* w, int* visible);
+void syncScene(Scene* s, const GameView* v);
+void paintWidget(const GameView* v, const Widget* w);
+int renderScene(const GameView* v, const std::vector<Effect>& effects);
+SceneRect rowArea(const GameView* v, int board, int row, int grow_x, int grow_y);
+void startEffect(const GameView* v, const Effect* e);
+
+//线程间传递
+ViewSnapshot viewCurrent(SpscLatest<ViewSnapshot>* slot);
+void publishView();
+void emitEffect(int kind, int board, int row);
+void emitRowEffect(int kind, int row);
+void setPage(int page);
+void emitTelemetry(int kind, const char* word);
 
 //事件处理
-int handleMouseClick();
-void handleGameInput();
+void inputLoop();
+void logicLoop();
+void handleCommand(const Command* c);
+void handleClick(int kind, int id);
+void handleKey(int vk);
+void requestHint();
 
 //主函数
 int main() {
     initGraphics();
-    initKeyboardLayout(); // 初始化键盘布局
+    rng_state = ((uint64_t)time(0) << 32) ^ GetTickCount();
+    session_id = sampleRandom(&rng_state);
+    telemetryCreate(&telemetry, TELEMETRY_NAME, TELEMETRY_SLOTS);
+    sceneInit(&scene, SCREEN_WIDTH, SCREEN_HEIGHT);
+    animInit(&animator);
     loadWordList();
+    startDictWatcher();
     loadStats();
-    bool running = true;
-    while (running) {
-        int click = handleMouseClick();
-        if (click == PAGE_EXIT) {
-            break;
-        } else if (click == PAGE_HELP || click == PAGE_STATS || click == PAGE_MAIN_MENU) {
-            current_page = (decltype(current_page))click;
-        }
-
-            switch (current_page) {
-            case PAGE_MAIN_MENU:
-                drawMainMenu();
-                break;
-            case PAGE_GAME:
-                drawGameScreen();
-                handleGameInput();
-                break;
-            case PAGE_HELP:
-                drawHelpScreen();
-                break;
-            case PAGE_STATS:
-                drawStatsScreen();
-                break;
-        }
-
-        FlushBatchDraw();
-        Sleep(16);
+    publishView();
+
+    std::thread logic(logicLoop);
+    // 输入线程阻塞在 getmessage 上，程序退出时随进程结束
+    std::thread(inputLoop).detach();
+
+    // 绘制线程：先取出动画事件再取快照。事件总在所属快照发布之后才入队，取到的快照不会比事件旧
+    std::vector<Effect> effects;
+    for (;;) {
+        effects.clear();
+        Effect e;
+        while (spscPop(&effect_queue, &e)) effects.push_back(e);
+        ViewSnapshot v = viewCurrent(&render_view);
+        if (v->page == PAGE_EXIT) break;
+
+        // 只重画并送出变化的区域；动画按时间采样，某帧晚了也不会拖慢动画
+        int animating = renderScene(v.get(), effects);
+        uint32_t frame = animating ? FRAME_MS : IDLE_FRAME_MS;
+        uint32_t spent = GetTickCount() - frame_time;
+        Sleep(spent < frame ? frame - spent : 0);
     }
 
+    logic.join();
+    archiveFlush(&archive);
+    playerStatsStopAutosave(&players);
+    saveStats();
     EndBatchDraw();
     closegraph();
     return 0;
@@ -149,729 +363,1515 @@ void initGraphics() {
     BeginBatchDraw();
 }
 
-int randInt(int max) {
-    return rand() % max;
+//按权重抽一个答案；不重复模式下本次运行内要抽完一轮才会再出现同一个词，词库热更新后重新开始
+uint32_t pickTarget(const Dictionary* d) {
+    if (!menu_no_repeat) return dictSampleTarget(d, sampleRandom(&rng_state));
+    if (target_sampler.key != d->hash || target_sampler.n != d->count) {
+        samplerReset(&target_sampler, dictWeights(d), d->count, d->hash);
+    }
+    return samplerNext(&target_sampler, dictWeights(d), &rng_state);
 }
 
-void loadWordList() {
-    FILE* fp = fopen("words.txt", "r");
-    if (!fp) {
-        const char* fallback[] = {
-            "HELLO", "WORLD", "APPLE", "TRAIN", "GUESS", "CODES", "SLATE", "CRANE",
-            "AUDIO", "STARE", "TEARS", "ALONE", "ADIEU", "LATER", "WHILE", "ABACK",
-            "CRAZE", "PLUMB", "FJORD", "GYPSY", "QUART", "ZEBRA", "JUMBO", "VIXEN"
-        };
-        word_count = sizeof(fallback) / sizeof(fallback[0]);
-        for (int i = 0; i < word_count && i < 1000; i++) {
-            strcpy(word_list[i], fallback[i]);
-        }
-        return;
+//查今天（本地日期）的每日一题，没有排期文件、排期不含今天或词库已变化时返回 DAILY_NONE
+uint32_t dailyTarget(const Dictionary* d) {
+    if (!daily_loaded || daily_schedule.dict_hash != d->hash) {
+        daily_loaded = dailyLoad(&daily_schedule, DAILY_FILE, d);
+        if (!daily_loaded) return DAILY_NONE;
     }
+    time_t now = time(0);
+    struct tm* t = localtime(&now);
+    return dailyLookup(&daily_schedule, d, dailyDayNumber(t->tm_year + 1900, t->tm_mon + 1, t->tm_mday));
+}
 
-    word_count = 0;
-    char line[100];
-    while (fgets(line, sizeof(line), fp)) {
-        line[strcspn(line, "\r\n")] = '\0';
-        if (strlen(line) == 0) continue;
-        if (strlen(line) == 5) {
-            int valid = 1;
-            for (int i = 0; i < 5; i++) {
-                if (line[i] >= 'a' && line[i] <= 'z') line[i] = line[i] - 'a' + 'A';
-                if (line[i] < 'A' || line[i] > 'Z') {
-                    valid = 0;
-                    break;
+//词库在构建时由 wordgen 编译进程序（words_table.h），启动时无需读取和解析 words.txt
+void loadWordList() {
+    auto d = std::make_shared<Dictionary>();
+    dictLoadTable(d.get(), &EMBEDDED_DICT);
+    dictPublish(d);
+}
+
+//后台线程监视工作目录，words.txt 被修改后重新加载并发布新快照。
+//加载在监视线程里完成，主线程取快照时不需要加锁
+void startDictWatcher() {
+    std::thread([]() {
+        HANDLE h = FindFirstChangeNotificationA(".", FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME);
+        if (h == INVALID_HANDLE_VALUE) return;
+        struct stat st;
+        time_t last_mtime = stat(WORDS_FILE, &st) == 0 ? st.st_mtime : 0;
+        while (WaitForSingleObject(h, INFINITE) == WAIT_OBJECT_0) {
+            Sleep(200); // 编辑器保存时可能分几次写入，稍等再读
+            if (stat(WORDS_FILE, &st) == 0 && st.st_mtime != last_mtime) {
+                last_mtime = st.st_mtime;
+                auto d = std::make_shared<Dictionary>();
+                if (dictLoadFile(d.get(), WORDS_FILE) && d->count > 0) {
+                    dictPublish(d);
                 }
             }
-            if (valid && word_count < 1000) {
-                strcpy(word_list[word_count], line);
-                word_count++;
-            }
+            if (!FindNextChangeNotification(h)) break;
         }
-    }
-    fclose(fp);
+        FindCloseChangeNotification(h);
+    }).detach();
 }
 
 void saveStats() {
-    FILE* fp = fopen("stats.dat", "wb");
-    if (fp) {
-        fwrite(&stats, sizeof(Statistics), 1, fp);
-        fclose(fp);
-    }
+    playerStatsSave(&players);
 }
 
 void loadStats() {
-    FILE* fp = fopen("stats.dat", "rb");
-    if (fp) {
-        fread(&stats, sizeof(Statistics), 1, fp);
-        fclose(fp);
-    } else {
-        memset(&stats, 0, sizeof(Statistics));
+    playerStatsInit(&players);
+    const char* name = getenv("USERNAME");
+    if (name && name[0]) {
+        snprintf(local_player_name, sizeof(local_player_name), "%s", name);
+    }
+    local_player_id = playerIdFromName(local_player_name);
+
+    if (playerStatsLoad(&players, PLAYERS_FILE) == PLAYERS_NEW) {
+        // 第一次建多玩家存档时导入旧版 stats.dat，作为本机玩家的记录
+        FILE* fp = fopen("stats.dat", "rb");
+        if (fp) {
+            Statistics legacy;
+            if (fread(&legacy, sizeof(Statistics), 1, fp) == 1) {
+                playerStatsImport(&players, local_player_id, &legacy);
+            }
+            fclose(fp);
+        }
     }
+    playerStatsSnapshot(&players, local_player_id, &stats);
+    leaderboardsInit(&leaderboards);
+    leaderboardsBuild(&leaderboards, &players);
+    playerStatsStartAutosave(&players, 2000);
+    archiveOpen(&archive, ARCHIVE_FILE);
 }
 
 void updateStats() {
-    stats.games_played++;
-    if (game.won) {
-        stats.games_won++;
-        stats.current_streak++;
-        if (stats.current_streak > stats.max_streak) {
-            stats.max_streak = stats.current_streak;
-        }
-        if (game.current_attempt <= MAX_ATTEMPTS) {
-            stats.guess_distribution[game.current_attempt - 1]++;
-        }
-    } else {
-        stats.current_streak = 0;
+    archiveGame();
+    // 对抗/多词模式的猜测次数分布与经典模式不可比，不计入统计
+    if (game.mode != MODE_CLASSIC && game.mode != MODE_DAILY) return;
+    playerStatsRecord(&players, local_player_id, game.won, game.current_attempt);
+    playerStatsSnapshot(&players, local_player_id, &stats);
+    leaderboardsUpdate(&leaderboards, local_player_id, &stats);
+}
+
+//把刚结束的一局写进档案，多词模式不记
+void archiveGame() {
+    if (game.board_count != 1) return;
+    const Dictionary* d = game.dict.get();
+    ArchiveGame g;
+    memset(&g, 0, sizeof(g));
+    g.player = local_player_id;
+    g.time = (int64_t)time(0);
+    g.target = game.target_ids[0];
+    g.mode = game.mode;
+    g.hard = game.hard_mode;
+    g.won = game.won;
+    g.attempts = game.current_attempt;
+    for (int r = 0; r < g.attempts; r++) {
+        g.guesses[r] = (uint32_t)dictIndexOf(d, game.guesses[r]);
+        g.patterns[r] = game.patterns[0][r];
     }
-    saveStats();
+    archiveAppend(&archive, d, &g);
 }
 
-void startNewGame(int hard_mode) {
-    srand((unsigned)time(0));
-    strcpy(game.target_word, word_list[randInt(word_count)]);
-    for (int i = 0; i < MAX_ATTEMPTS; i++) {
-        game.guesses[i][0] = '\0';
+//按统计页面当前的筛选重算：不筛选时显示累计的 stats，否则从档案现算
+void refreshStatsView() {
+    StatsView* sv = &stats_view;
+    uint32_t t0 = GetTickCount();
+    ArchiveFilter f = { local_player_id, 0, 0, 0 };
+    if (STATS_RANGE_DAYS[sv->range] > 0) f.since = (int64_t)time(0) - (int64_t)STATS_RANGE_DAYS[sv->range] * 86400;
+    switch (sv->mode) {
+    case 0: f.kinds = archiveKind(MODE_CLASSIC, 0) | archiveKind(MODE_CLASSIC, 1) | archiveKind(MODE_DAILY, 0) | archiveKind(MODE_DAILY, 1); break;
+    case 1: f.kinds = archiveKind(MODE_CLASSIC, 0); break;
+    case 2: f.kinds = archiveKind(MODE_CLASSIC, 1); break;
+    case 3: f.kinds = archiveKind(MODE_DAILY, 0) | archiveKind(MODE_DAILY, 1); break;
+    case 4: f.kinds = archiveKind(MODE_ABSURDLE, 0) | archiveKind(MODE_ABSURDLE, 1); break;
     }
-    for (int i = 0; i < 26; i++) {
-        game.key_status[i] = 0;
+    if (sv->range != 0 || sv->mode != 0) archiveStats(&archive, &f, &sv->filtered);
+
+    DictSnapshot dict = dictCurrent();
+    const Dictionary* d = dict.get();
+    std::vector<uint32_t> counts(d->count);
+    archiveOpeners(&archive, d, &f, counts.data());
+    int best = (int)(std::max_element(counts.begin(), counts.end()) - counts.begin());
+    sv->opener_count = counts.empty() ? 0 : (int)counts[best];
+    sv->opener[0] = '\0';
+    if (sv->opener_count > 0) alphabetDecode(&d->alphabet, dictWord(d, best), sv->opener);
+    sv->archived = archive.games;
+    sv->elapsed_ms = (float)(GetTickCount() - t0);
+}
+
+void startNewGame(int hard_mode, int mode, int board_count) {
+    game.dict = dictCurrent();
+    const Dictionary* dict = game.dict.get();
+    // 多词模式的词数不能超过能当答案的词数：减半到够用为止（仍是 2 的幂，盘面排得开），不到两个词时退回经典模式
+    int multi_short = 0;
+    if (mode == MODE_MULTI) {
+        while (board_count > 1 && board_count > dict->target_count) board_count /= 2;
+        multi_short = board_count < 2;
+        if (multi_short) mode = MODE_CLASSIC;
     }
+    if (mode != MODE_MULTI) board_count = 1;
+    // 今天没有排期时退回经典模式随机出题
+    uint32_t daily = mode == MODE_DAILY ? dailyTarget(dict) : DAILY_NONE;
+    int daily_missing = mode == MODE_DAILY && daily == DAILY_NONE;
+    if (daily_missing) mode = MODE_CLASSIC;
+    game.mode = mode;
+    game.board_count = board_count;
+    game.max_attempts = board_count + MAX_ATTEMPTS - 1;
+    if (mode == MODE_ABSURDLE) {
+        game.target_word[0][0] = '\0';     // 候选由 resetCandidates 设为所有能当答案的词
+    } else if (mode == MODE_DAILY) {
+        game.target_ids[0] = daily;
+        alphabetDecode(&dict->alphabet, dictWord(dict, daily), game.target_word[0]);
+    } else {
+        for (int b = 0; b < board_count; b++) {
+            int dup;
+            do {
+                game.target_ids[b] = pickTarget(dict);
+                dup = 0;
+                for (int k = 0; k < b; k++) {
+                    if (game.target_ids[k] == game.target_ids[b]) dup = 1;
+                }
+            } while (dup);
+            alphabetDecode(&dict->alphabet, dictWord(dict, game.target_ids[b]), game.target_word[b]);
+        }
+    }
+    game.typed = 0;
+    game.prefix_nodes[0] = dict->root;
+    game.completions[0] = '\0';
+    for (int b = 0; b < MAX_BOARDS; b++) {
+        game.solved_at[b] = -1;
+        for (int i = 0; i < MAX_ALPHABET; i++) {
+            game.key_status[b][i] = 0;
+        }
+    }
+    initKeyboardLayout(&dict->alphabet); // 键盘按本局词库的字母表布局
     game.current_attempt = 0;
     game.game_over = 0;
     game.won = 0;
     game.invalid_word = 0;
     game.hint_used = 0;
     game.hint_message[0] = '\0';
-    game.hard_mode = hard_mode;
-    current_page = PAGE_GAME;
+    game.hint_word[0] = '\0';
+    game.hint_detail[0] = '\0';
+    resetCandidates();
+    if (daily_missing) strcpy(game.hint_message, "今日无排期，已随机出题");
+    if (multi_short) strcpy(game.hint_message, "能当答案的词不够，已改为经典模式");
+    game.hard_mode = board_count == 1 ? hard_mode : 0; // 多个盘面的线索可能互相矛盾，不支持困难规则
+    game.hard_legal_count = 0;
+    setPage(PAGE_GAME);                  // 盘面个数、键盘可能变了，重新布局
+    emitTelemetry(TEL_GAME_START, nullptr);
 }
 
-int isValidWord(const char* word) {
-    for (int i = 0; i < word_count; i++) {
-        if (strcmp(word, word_list[i]) == 0) return 1;
-    }
-    return 0;
+int isValidWord(const uint8_t* word) {
+    return dictContains(game.dict.get(), word);
 }
 
-int satisfiesHardMode(const char* guess) {
+//收集当前对局（第一个盘面）已揭示的困难模式约束
+void collectHardConstraints(HardConstraints* hc) {
+    hardCollect(hc, &game.guesses[0][0], game.patterns[0], game.current_attempt);
+}
+
+int satisfiesHardMode(const uint8_t* guess) {
     if (!game.hard_mode) return 1;
 
-    char must_use[256] = {0};
-    char fixed_pos[5] = {0};
+    HardConstraints hc;
+    collectHardConstraints(&hc);
+    return hardSatisfies(&hc, guess);
+}
 
-    for (int row = 0; row < game.current_attempt; row++) {
-        int result[WORD_LENGTH];
-        checkGuess(game.guesses[row], result);
-        for (int i = 0; i < WORD_LENGTH; i++) {
-            char c = game.guesses[row][i];
-            if (result[i] == GREEN) {
-                fixed_pos[i] = c;
-            }
-            if (result[i] == GREEN || result[i] == YELLOW) {
-                must_use[(unsigned char)c] = 1;
-            }
+//对抗模式：把候选词按反馈分组，保留最大的一组作为回应，其余各组从频率表里减掉
+uint8_t absurdleRespond(const uint8_t* g) {
+    int n = (int)tracked_candidates.size();
+    std::vector<uint8_t> patterns(n);
+    std::vector<uint32_t> sorted(n);
+    int bucket_start[PATTERN_COUNT + 1];
+    partitionByPattern(game.dict.get(), g, tracked_candidates.data(), n, patterns.data(), sorted.data(), bucket_start);
+
+    // 组一样大时选透露信息最少的（黄绿格子的权重最小），不到万不得已不给全绿
+    int best = -1, best_size = 0, best_score = 0;
+    for (int p = 0; p < PATTERN_COUNT; p++) {
+        int size = bucket_start[p + 1] - bucket_start[p];
+        if (size == 0) continue;
+        int result[WORD_LENGTH], score = 0;
+        decodePattern((uint8_t)p, result);
+        for (int i = 0; i < WORD_LENGTH; i++) score += result[i] - 1;
+        if (p == PATTERN_ALL_GREEN) score = 3 * WORD_LENGTH;
+        if (best < 0 || size > best_size || (size == best_size && score < best_score)) {
+            best = p;
+            best_size = size;
+            best_score = score;
         }
     }
+    freqRemoveWords(&letter_freq, game.dict.get(), sorted.data(), bucket_start[best]);
+    freqRemoveWords(&letter_freq, game.dict.get(), sorted.data() + bucket_start[best + 1], n - bucket_start[best + 1]);
+    tracked_candidates.assign(sorted.begin() + bucket_start[best], sorted.begin() + bucket_start[best + 1]);
+    return (uint8_t)best;
+}
 
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        if (fixed_pos[i] && guess[i] != fixed_pos[i]) {
-            return 0;
-        }
+//提交当前行
+void submitGuess() {
+    const uint8_t* guess = game.guesses[game.current_attempt];
+    game.hint_word[0] = '\0';
+    game.hint_detail[0] = '\0';
+    char text[WORD_TEXT_MAX];
+    alphabetDecode(&game.dict->alphabet, guess, text);
+    if (!isValidWord(guess)) {
+        game.invalid_word = 1;
+        game.hint_message[0] = '\0';
+        emitRowEffect(FX_SHAKE, game.current_attempt);
+        emitTelemetry(TEL_INVALID, text);
+        return;
     }
-
-    char has[256] = {0};
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        has[(unsigned char)guess[i]] = 1;
+    if (!satisfiesHardMode(guess)) {
+        game.invalid_word = 1;
+        strcpy(game.hint_message, "困难模式：必须使用已揭示的线索！");
+        emitRowEffect(FX_SHAKE, game.current_attempt);
+        emitTelemetry(TEL_INVALID, text);
+        return;
     }
-    for (int c = 'A'; c <= 'Z'; c++) {
-        if (must_use[c] && !has[c]) {
-            return 0;
+    game.invalid_word = 0;
+    game.hint_message[0] = '\0';
+
+    int row = game.current_attempt;
+    if (game.mode == MODE_ABSURDLE) {
+        game.patterns[0][row] = absurdleRespond(guess);
+    } else {
+        // 所有未猜中的盘面一次批量打分
+        uint32_t ids[MAX_BOARDS];
+        int boards[MAX_BOARDS];
+        uint8_t out[MAX_BOARDS];
+        int n = 0;
+        for (int b = 0; b < game.board_count; b++) {
+            if (game.solved_at[b] < 0) {
+                ids[n] = game.target_ids[b];
+                boards[n++] = b;
+            }
+        }
+        scoreBatch(game.dict.get(), guess, ids, n, out);
+        for (int k = 0; k < n; k++) {
+            game.patterns[boards[k]][row] = out[k];
         }
     }
 
-    return 1;
-}
-
-void checkGuess(char* guess, int* result) {
-    int used[WORD_LENGTH] = {0};
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        if (guess[i] == game.target_word[i]) {
-            result[i] = 3; // GREEN
-            used[i] = 1;
-        } else {
-            result[i] = 1; // LIGHTGRAY
+    emitRowEffect(FX_REVEAL, row);
+    updateKeyboardStatus(row);
+    filterCandidates(row);
+    int solved = 0;
+    for (int b = 0; b < game.board_count; b++) {
+        if (game.solved_at[b] < 0 && game.patterns[b][row] == PATTERN_ALL_GREEN) {
+            game.solved_at[b] = row;
+            emitEffect(FX_BOUNCE, b, row);
         }
+        if (game.solved_at[b] >= 0) solved++;
     }
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        if (result[i] != 3) {
-            for (int j = 0; j < WORD_LENGTH; j++) {
-                if (!used[j] && guess[i] == game.target_word[j]) {
-                    result[i] = 2; // YELLOW
-                    used[j] = 1;
-                    break;
-                }
-            }
+    if (solved == game.board_count) {
+        game.won = 1;
+        game.game_over = 1;
+    }
+    game.current_attempt++;
+    game.typed = 0;
+    if (game.current_attempt >= game.max_attempts) {
+        game.game_over = 1;
+    }
+    emitTelemetry(TEL_GUESS, text);
+    if (game.hard_mode && !game.game_over) {
+        HardConstraints hc;
+        collectHardConstraints(&hc);
+        hard_legal.resize(game.dict->count);
+        game.hard_legal_count = hardEnumerate(game.dict.get(), &hc, hard_legal.data());
+    }
+    if (game.game_over) {
+        if (game.mode == MODE_ABSURDLE) {
+            game.target_ids[0] = tracked_candidates[0];
+            alphabetDecode(&game.dict->alphabet, dictWord(game.dict.get(), tracked_candidates[0]), game.target_word[0]);
         }
+        updateStats();
+        emitTelemetry(game.won ? TEL_GAME_WON : TEL_GAME_LOST, game.target_word[0]);
     }
 }
 
-void provideHint() {
-    if (game.hint_used || game.game_over || game.current_attempt == 0) return;
-
-    char* last_guess = game.guesses[game.current_attempt - 1];
-    int result[WORD_LENGTH];
-    checkGuess(last_guess, result);
+//经典模式前两步的建议词，没有时返回 OPENING_NONE
+uint32_t openingSuggest() {
+    const Dictionary* d = game.dict.get();
+    int hard = game.hard_mode ? 1 : 0;
+    OpeningBook* book = &opening_books[hard];
+    // 词库热更新后 hash 不同，重新读取（文件也过期时会重新生成）
+    if (!opening_loaded[hard] || book->dict_hash != d->hash || book->count != d->count) {
+        openingLoadOrBuild(book, openingDefaultPath(hard), d, hard);
+        opening_loaded[hard] = 1;
+    }
+    uint8_t pattern = game.patterns[0][0];
+    return openingLookup(book, d, game.current_attempt, game.guesses[0], &pattern);
+}
 
-    int yellow_index = -1;
-    for (int i = 0; i < WORD_LENGTH; i++) {
-        if (result[i] == 2) {
-            yellow_index = i;
-            break;
+void provideHint() {
+    if (game.hint_used || game.game_over) return;
+    game.hint_word[0] = '\0';
+    game.hint_detail[0] = '\0';
+    const Dictionary* d = game.dict.get();
+
+    // 单盘面时附带各位置最常见的字母，开局库给出的提示也有
+    if (game.board_count == 1) {
+        for (int p = 0; p < WORD_LENGTH; p++) {
+            float share = 0;
+            game.hint_letters[p] = (int8_t)freqTopAt(&letter_freq, p, d->alphabet.size, &share);
+            game.hint_shares[p] = (uint8_t)(share * 100 + 0.5f);
         }
     }
 
-    if (yellow_index != -1) {
-        char letter = last_guess[yellow_index];
-        for (int pos = 0; pos < WORD_LENGTH; pos++) {
-            if (game.target_word[pos] == letter && last_guess[pos] != letter) {
-                sprintf(game.hint_message, "建议：将 '%c' 移到第 %d 位", letter, pos + 1);
-                game.hint_used = 1;
-                return;
-            }
+    // 前两步直接给出开局库里的词
+    if ((game.mode == MODE_CLASSIC || game.mode == MODE_DAILY) && game.current_attempt < 2) {
+        uint32_t w = openingSuggest();
+        if (w != OPENING_NONE) {
+            sprintf(game.hint_message, "建议%s：", game.current_attempt == 0 ? "开局" : "第二步");
+            alphabetDecode(&d->alphabet, dictWord(d, w), game.hint_word);
+            game.hint_used = 1;
+            return;
         }
-        sprintf(game.hint_message, "字母 '%c' 在词中但位置不对", letter);
+    }
+
+    // 多词模式下针对第一个还没猜中的盘面，由搜索按反馈推出候选；单盘面（含对抗模式）直接用跟踪的候选
+    int board = 0;
+    while (board < game.board_count - 1 && game.solved_at[board] >= 0) board++;
+    SolverState s = { d, game.hard_mode, game.current_attempt, &game.guesses[0][0], game.patterns[board], nullptr, 0 };
+    if (game.board_count == 1) {
+        s.candidates = tracked_candidates.data();
+        s.candidate_count = (int)tracked_candidates.size();
+    }
+    float expected = 0;
+    uint32_t w = hintSearch(&hint_engine, &s, &expected);
+    if (w == HINT_NONE) return;
+
+    if (game.mode == MODE_ABSURDLE) {
+        sprintf(game.hint_message, "剩余候选 %d 个，建议：", (int)tracked_candidates.size());
     } else {
-        int guess_has[256] = {0};
-        for (int i = 0; i < WORD_LENGTH; i++) {
-            guess_has[(unsigned char)last_guess[i]] = 1;
-        }
-        for (int i = 0; i < WORD_LENGTH; i++) {
-            char c = game.target_word[i];
-            if (!guess_has[(unsigned char)c]) {
-                sprintf(game.hint_message, "建议：尝试包含字母 '%c'", c);
-                game.hint_used = 1;
-                return;
-            }
-        }
-        strcpy(game.hint_message, "已覆盖所有字母，请调整位置！");
+        sprintf(game.hint_message, "建议（约再猜 %.1f 次）：", expected);
     }
+    alphabetDecode(&d->alphabet, dictWord(d, w), game.hint_word);
+    const HintStats* hs = &hint_engine.stats;
+    snprintf(game.hint_detail, sizeof(game.hint_detail), "展开 %u 个局面，节点 %u，内存 %u KB",
+             hs->expanded, hs->node_peak, (unsigned)((hs->arena_peak + 1023) / 1024));
     game.hint_used = 1;
 }
 
 //键盘相关
-void updateKeyboardStatus() {
-    int new_status[26] = {0};
-
-    for (int row = 0; row < game.current_attempt; row++) {
+//把刚提交的一行合并进各盘面的键盘状态（状态只升不降：绿 > 黄 > 灰 > 未用）
+void updateKeyboardStatus(int row) {
+    for (int b = 0; b < game.board_count; b++) {
+        if (game.solved_at[b] >= 0 && game.solved_at[b] < row) continue;
         int result[WORD_LENGTH];
-        checkGuess(game.guesses[row], result);
+        decodePattern(game.patterns[b][row], result);
         for (int i = 0; i < WORD_LENGTH; i++) {
-            char c = game.guesses[row][i];
-            int idx = c - 'A';
-            if (result[i] == 3) {
-                new_status[idx] = 3;
-            } else if (result[i] == 2) {
-                if (new_status[idx] != 3) new_status[idx] = 2;
-            } else {
-                if (new_status[idx] == 0) new_status[idx] = 1;
+            int idx = game.guesses[row][i];
+            if (result[i] > game.key_status[b][idx]) {
+                game.key_status[b][idx] = result[i];
             }
         }
     }
+}
+
+//键盘热度：含这个字母的候选占比，换算到 0..255
+static void updateKeyHeat() {
+    int n = letter_freq.count;
+    for (int c = 0; c < MAX_ALPHABET; c++) {
+        game.key_heat[c] = n > 0 ? (uint8_t)((uint64_t)letter_freq.any[c] * 255 / n) : 0;
+    }
+    game.candidate_count = n;
+}
 
-    for (int i = 0; i < 26; i++) {
-        game.key_status[i] = new_status[i];
+//开新局：能当答案（出题权重 > 0）的词都是候选；每个词都能当答案时频率表直接取词库预先算好的整表
+void resetCandidates() {
+    const Dictionary* d = game.dict.get();
+    for (int p = 0; p < WORD_LENGTH; p++) game.hint_letters[p] = -1;
+    if (game.board_count != 1) {
+        tracked_candidates.clear();
+        memset(game.key_heat, 0, sizeof(game.key_heat));
+        game.candidate_count = 0;
+        return;
     }
+    tracked_candidates.clear();
+    for (int i = 0; i < d->count; i++) {
+        if (dictIsTarget(d, i)) tracked_candidates.push_back((uint32_t)i);
+    }
+    if ((int)tracked_candidates.size() == d->count) freqFromDict(&letter_freq, d);
+    else freqFromWords(&letter_freq, d, tracked_candidates.data(), (int)tracked_candidates.size());
+    updateKeyHeat();
 }
 
-void initKeyboardLayout() {
+//按刚提交那一行的反馈筛候选，淘汰的词从频率表里减掉；对抗模式在 absurdleRespond 里已经筛过
+void filterCandidates(int row) {
+    if (game.board_count != 1) return;
+    if (game.mode == MODE_ABSURDLE) {
+        updateKeyHeat();
+        return;
+    }
+    int n = freqFilter(&letter_freq, game.dict.get(), tracked_candidates.data(), (int)tracked_candidates.size(),
+                       game.guesses[row], game.patterns[0][row]);
+    tracked_candidates.resize(n);
+    updateKeyHeat();
+}
+
+//输入一个字母，同时沿 DAWG 前进一步
+void appendLetter(int sym) {
+    if (game.game_over || game.current_attempt >= game.max_attempts) return;
+    if (sym < 0 || sym >= game.dict->alphabet.size) return;
+    int len = game.typed;
+    if (len >= WORD_LENGTH) return;
+    game.guesses[game.current_attempt][len] = (uint8_t)sym;
+    game.typed++;
+    game.prefix_nodes[len + 1] = dictStep(game.dict.get(), game.prefix_nodes[len], sym);
+    game.invalid_word = 0;
+    updateCompletions();
+}
+
+void removeLetter() {
+    if (game.game_over || game.current_attempt >= game.max_attempts) return;
+    if (game.typed > 0) {
+        game.typed--;
+        game.invalid_word = 0;
+        updateCompletions();
+    }
+}
+
+//当前前缀只能拼出几个词时，从 DAWG 枚举出来显示在输入行下方
+void updateCompletions() {
+    game.completions[0] = '\0';
+    int len = game.typed;
+    if (len == 0 || len >= WORD_LENGTH) return;
+    const Dictionary* d = game.dict.get();
+    const uint8_t* prefix = game.guesses[game.current_attempt];
+    if (dictPrefixCount(d, prefix, len) > COMPLETIONS_SHOWN) return;
+    uint8_t words[COMPLETIONS_SHOWN * WORD_LENGTH];
+    int n = dictCompletions(d, prefix, len, words, COMPLETIONS_SHOWN);
+    char* p = game.completions;
+    for (int i = 0; i < n; i++) {
+        if (i > 0) *p++ = ' ';
+        alphabetDecode(&d->alphabet, words + i * WORD_LENGTH, p);
+        p += strlen(p);
+    }
+}
+
+//WM_CHAR 送来的是系统代码页的字节（双字节代码页下一个字分两次送来），转成字母编号，不是字母返回 -1
+int charToSymbol(unsigned char c) {
+    static char lead = 0;
+    char bytes[2];
+    int n;
+    if (lead) {
+        bytes[0] = lead;
+        bytes[1] = (char)c;
+        n = 2;
+        lead = 0;
+    } else if (IsDBCSLeadByte(c)) {
+        lead = (char)c;
+        return -1;
+    } else {
+        bytes[0] = (char)c;
+        n = 1;
+    }
+    wchar_t w[2];
+    if (MultiByteToWideChar(CP_ACP, 0, bytes, n, w, 2) != 1) return -1;
+    uint32_t cp = foldSymbol(w[0]);
+    if (!isWordSymbol(cp)) return -1;
+    return alphabetFind(&game.dict->alphabet, cp);
+}
+
+void initKeyboardLayout(const Alphabet* a) {
+    memset(keys, 0, sizeof(keys));
     int start_y = 500;
-    for (int r = 0; r < 3; r++) {
-        int len = row_lengths[r];
-        int start_x = (SCREEN_WIDTH - len * 60) / 2;
-        const char* row = keyboard_rows[r];
-        for (int i = 0; i < len; i++) {
-            char c = row[i];
-            int idx = c - 'A';
-            keys[idx].ch = c;
-            keys[idx].x = start_x + i * 60;
-            keys[idx].y = start_y + r * 55;
-            keys[idx].w = 55;
-            keys[idx].h = 45;
+    int rows_used = 0;
+    if (a->latin) {
+        for (int r = 0; r < 3; r++) {
+            int len = row_lengths[r];
+            int start_x = (SCREEN_WIDTH - len * 60) / 2;
+            const char* row = keyboard_rows[r];
+            for (int i = 0; i < len; i++) {
+                int idx = row[i] - 'A';
+                keys[idx] = { start_x + i * 60, start_y + r * 55, 55, 45, 1 };
+            }
         }
+        rows_used = 3;
+    }
+
+    // 其余符号：英文字母表下排成第 4 行，其它字母表排成 3~4 行，一行放不下时缩小键宽
+    int first = a->latin ? 26 : 0;
+    int rest = a->size - first;
+    if (rest <= 0) return;
+    int rows = a->latin ? 1 : (rest <= 30 ? 3 : 4);
+    int per_row = (rest + rows - 1) / rows;
+    int pitch = per_row * 60 <= 800 ? 60 : 800 / per_row;
+    for (int i = 0; i < rest; i++) {
+        int r = i / per_row, col = i % per_row;
+        int len = rest - r * per_row < per_row ? rest - r * per_row : per_row;
+        int start_x = (SCREEN_WIDTH - len * pitch) / 2;
+        keys[first + i] = { start_x + col * pitch, start_y + (rows_used + r) * 55, pitch - 5, 45, 1 };
     }
 }
 
-void drawKeyboard() {
+//一个按键：多词模式下按盘面切成小块（2 个 2x1，4 个 2x2，8 个 4x2，16 个 4x4），已猜中的盘面显示为未用
+void drawKey(const GameView* v, int sym) {
     COLORREF key_colors[] = { LIGHTGRAY, DARKGRAY, YELLOW, GREEN };
-    for (int i = 0; i < 26; i++) {
-        if (keys[i].ch == 0) continue;
-        int status = game.key_status[i];
-        setfillcolor(key_colors[status]);
-        settextcolor(BLACK);
-        solidroundrect(keys[i].x, keys[i].y,
-                      keys[i].x + keys[i].w,
-                      keys[i].y + keys[i].h, 8, 8);
-        roundrect(keys[i].x, keys[i].y,
-                  keys[i].x + keys[i].w,
-                  keys[i].y + keys[i].h, 8, 8);
-        char txt[2] = {keys[i].ch, '\0'};
-        outtextxy(keys[i].x + 15, keys[i].y + 10, txt);
+    int seg_cols = v->game.board_count <= 4 ? (v->game.board_count == 1 ? 1 : 2) : 4;
+    int seg_rows = v->game.board_count / seg_cols;
+    const Key* k = &v->keys[sym];
+    if (v->game.board_count == 1) {
+        int status = v->game.key_status[0][sym];
+        if (v->menu_heat && status == 0) {
+            // 热度：候选里越常见越接近橙色
+            int heat = v->game.key_heat[sym];
+            setfillcolor(RGB(211 + 44 * heat / 255, 211 - 71 * heat / 255, 211 - 211 * heat / 255));
+        } else {
+            setfillcolor(key_colors[status]);
+        }
+        solidroundrect(k->x, k->y, k->x + k->w, k->y + k->h, 8, 8);
+    } else {
+        for (int b = 0; b < v->game.board_count; b++) {
+            int status = v->game.solved_at[b] >= 0 ? 0 : v->game.key_status[b][sym];
+            int sx = k->x + k->w * (b % seg_cols) / seg_cols;
+            int sy = k->y + k->h * (b / seg_cols) / seg_rows;
+            int ex = k->x + k->w * (b % seg_cols + 1) / seg_cols;
+            int ey = k->y + k->h * (b / seg_cols + 1) / seg_rows;
+            setfillcolor(key_colors[status]);
+            solidrectangle(sx, sy, ex, ey);
+        }
     }
-
-    setfillcolor(LIGHTRED);
-    solidroundrect(SCREEN_WIDTH - 100, SCREEN_HEIGHT - 170, SCREEN_WIDTH - 30, SCREEN_HEIGHT - 125, 8, 8);
-    roundrect(SCREEN_WIDTH - 100, SCREEN_HEIGHT - 170, SCREEN_WIDTH - 30, SCREEN_HEIGHT - 125, 8, 8);
-    outtextxy(SCREEN_WIDTH - 90, SCREEN_HEIGHT - 160, "DEL");
+    roundrect(k->x, k->y, k->x + k->w, k->y + k->h, 8, 8);
+    const char* txt = v->game.dict->alphabet.symbols[sym];
+    outUtf8(k->x + (k->w - utf8Width(txt)) / 2, k->y + 10, txt);
 }
 
 //绘图函数
-void drawCell(int x, int y, int size, char c, int color_idx) {
+//显示 UTF-8 文本（单词、字母表符号）：纯 ASCII 直接用 outtextxy，
+//其余转成 UTF-16 用 TextOutW 画到 EasyX 的绘图设备上，不受系统代码页限制
+void outUtf8(int x, int y, const char* text) {
+    int ascii = 1;
+    for (const char* p = text; *p; p++) {
+        if ((unsigned char)*p >= 0x80) ascii = 0;
+    }
+    if (ascii) {
+        outtextxy(x, y, text);
+        return;
+    }
+    wchar_t w[64];
+    int n = MultiByteToWideChar(CP_UTF8, 0, text, -1, w, 64);
+    if (n <= 1) return;
+    HDC hdc = GetImageHDC();
+    SetBkMode(hdc, TRANSPARENT);
+    SetTextColor(hdc, gettextcolor());
+    TextOutW(hdc, x, y, w, n - 1);
+}
+
+int utf8Width(const char* text) {
+    wchar_t w[64];
+    int n = MultiByteToWideChar(CP_UTF8, 0, text, -1, w, 64);
+    if (n <= 1) return 0;
+    SIZE sz;
+    GetTextExtentPoint32W(GetImageHDC(), w, n - 1, &sz);
+    return sz.cx;
+}
+
+void drawCell(const GameView* v, int x, int y, int size, int sym, int color_idx) {
+    drawCellHeight(v, x, y, size, size, sym, color_idx);
+}
+
+//翻动中的格子高度小于宽度，上下居中；压得太扁时不画字
+void drawCellHeight(const GameView* v, int x, int y, int size, int height, int sym, int color_idx) {
     COLORREF colors[] = { WHITE, LIGHTGRAY, YELLOW, GREEN };
     COLORREF fill = (color_idx >= 0 && color_idx <= 3) ? colors[color_idx] : RED;
 
+    int top = y + (size - height) / 2;
     setlinecolor(BLACK);
     setfillcolor(fill);
-    fillrectangle(x, y, x + size, y + size);
-    rectangle(x, y, x + size, y + size);
-    if (c != ' ') {
-        char ch[2] = { c, '\0' };
+    fillrectangle(x, top, x + size, top + height);
+    rectangle(x, top, x + size, top + height);
+    if (sym < 0 || height * 4 < size * 3) return;
+    const char* ch = v->game.dict->alphabet.symbols[sym];
+    if (size == CELL_SIZE) {
         settextcolor(BLACK);
-        outtextxy(x + size/2 - 8, y + size/2 - 12, ch);
+        outUtf8(x + (size - utf8Width(ch)) / 2, y + size/2 - 12, ch);
+    } else if (size >= 12) {
+        // 多词模式的小格子按比例缩小字号
+        int font = size * 2 / 3;
+        settextstyle(font, 0, "SimSun");
+        settextcolor(BLACK);
+        outUtf8(x + (size - utf8Width(ch)) / 2, y + (size - font) / 2, ch);
+        settextstyle(24, 0, "SimSun");
     }
 }
 
-void drawMainMenu() {
-    setfillcolor(RGB(245, 245, 255));
-    fillrectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
-
-    // 装饰波浪
-    setfillcolor(RGB(230, 240, 255));
-    for (int i = -100; i < SCREEN_WIDTH + 100; i += 80) {
-        fillellipse(i, -30, 100, 60);
+//按动画状态画格子：翻开时先把输入时的样子压扁，过了一半换成反馈颜色再展开；
+//摇晃、跳起只移动位置，移动范围已包含在补间的重画区域里
+void drawAnimatedCell(const GameView* v, const Widget* w) {
+    int col = w->id % WORD_LENGTH, row = w->id / WORD_LENGTH % MAX_GUESSES, board = w->id / WORD_LENGTH / MAX_GUESSES;
+    int target = board * MAX_GUESSES + row;
+    int sym, color;
+    cellState(v, board, row, col, &sym, &color);
+    int x = w->rect.x0, y = w->rect.y0, size = w->rect.x1 - w->rect.x0;
+    int height = size;
+
+    float p = animProgress(&animator, ANIM_FLIP, target, col, frame_time);
+    if (p >= 0 && p < 1) {
+        if (p < 0.5f) color = 1; // 还没翻过来
+        height = (int)(size * (p < 0.5f ? 1 - 2 * p : 2 * p - 1));
     }
+    p = animProgress(&animator, ANIM_SHAKE, target, 0, frame_time);
+    if (p >= 0) x += (int)animShakeOffset(p, SHAKE_PX);
+    p = animProgress(&animator, ANIM_BOUNCE, target, col, frame_time);
+    if (p >= 0) y -= (int)animBounceOffset(p, BOUNCE_PX);
 
-    // 标题带阴影
-    settextcolor(RGB(80, 80, 80));
-    outtextxy(432, 72, "W O R D L E");
-    settextcolor(GREEN);
-    outtextxy(430, 70, "W O R D L E");
+    drawCellHeight(v, x, y, size, height, sym, color);
+}
 
-    settextcolor(DARKGRAY);
-    outtextxy(417, 142, "Enjoy yourself!");
-    settextcolor(BLACK);
-    outtextxy(415, 140, "Enjoy yourself!");
-
-    // 按钮背景板
-    setfillcolor(WHITE);
-    solidroundrect(350, 180, 650, 550, 20, 20);
-    setlinecolor(LIGHTGRAY);
-    roundrect(350, 180, 650, 550, 20, 20);
-
-    mainButtons[0] = { 380, 200, 240, 50, "简单模式", PAGE_GAME };
-    mainButtons[1] = { 380, 270, 240, 50, "游戏说明", PAGE_HELP };
-    mainButtons[2] = { 380, 340, 240, 50, "统计数据", PAGE_STATS };
-    mainButtons[3] = { 380, 410, 240, 50, "退出游戏", PAGE_EXIT };
-    mainButtons[4] = { 380, 480, 240, 50, "困难模式", PAGE_GAME };
-
-    // 制作信息
-    settextcolor(DARKGRAY);
-    outtextxy(10, 600, "制作者：健雄书院");
-    outtextxy(90, 640, "王同学 陆同学");
-    outtextxy(90, 680, "曾同学 孙同学");
-
-    // 按钮绘制
-    for (int i = 0; i < 5; i++) {
-        COLORREF btnColor = (i == 0 || i == 4) ? RGB(220, 240, 220) : LIGHTGRAY;
-        setfillcolor(btnColor);
-        solidroundrect(mainButtons[i].x, mainButtons[i].y,
-                       mainButtons[i].x + mainButtons[i].w,
-                       mainButtons[i].y + mainButtons[i].h, 10, 10);
-        setlinecolor(BLACK);
-        roundrect(mainButtons[i].x, mainButtons[i].y,
-                  mainButtons[i].x + mainButtons[i].w,
-                  mainButtons[i].y + mainButtons[i].h, 10, 10);
-        settextcolor(BLACK);
-        outtextxy(mainButtons[i].x + 60, mainButtons[i].y + 15, mainButtons[i].text);
+//盘面格子的内容：sym 为 -1 表示空格子，color 为 drawCell 的颜色下标；已猜中的盘面在猜中那一行之后留空
+void cellState(const GameView* v, int board, int row, int col, int* sym, int* color) {
+    *sym = -1;
+    *color = 0; // WHITE
+    if (v->game.solved_at[board] >= 0 && row > v->game.solved_at[board]) {
+        // 空格子
+    } else if (row < v->game.current_attempt) {
+        int result[WORD_LENGTH];
+        decodePattern(v->game.patterns[board][row], result);
+        *sym = v->game.guesses[row][col];
+        *color = result[col];
+    } else if (row == v->game.current_attempt && col < v->game.typed) {
+        *sym = v->game.guesses[row][col];
+        if (v->game.invalid_word && v->game.typed == WORD_LENGTH) {
+            *color = -1; // RED
+        } else if (v->game.prefix_nodes[col + 1] == DAWG_NONE) {
+            *color = -1; // 从这个字母起已不可能拼出词库中的单词
+        } else {
+            *color = 1; // LIGHTGRAY
+        }
     }
 }
 
-void drawGameScreen() {
-    setfillcolor(RGB(250, 250, 255));
-    fillrectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
-
-    // 顶部状态栏
-    setfillcolor(RGB(245, 250, 255));
-    fillrectangle(0, 0, SCREEN_WIDTH, 60);
-    setlinecolor(LIGHTGRAY);
-    line(0, 60, SCREEN_WIDTH, 60);
-
-    settextstyle(24, 0, "SimSun");
-    settextcolor(BLACK);
-    char title[100];
-    sprintf(title, "WORDLE - 第 %d / %d 轮", game.current_attempt + 1, MAX_ATTEMPTS);
-    outtextxy(410, 20, title);
-
-    int startX = (SCREEN_WIDTH - WORD_LENGTH * CELL_SIZE) / 2;
-    int startY = 80;
-
-    for (int row = 0; row < MAX_ATTEMPTS; row++) {
-        for (int col = 0; col < WORD_LENGTH; col++) {
-            int x = startX + col * CELL_SIZE;
-            int y = startY + row * (CELL_SIZE + 10);
-            char ch = ' ';
-            int color_idx = 0; // WHITE
-
-            if (row < game.current_attempt) {
-                int result[WORD_LENGTH];
-                checkGuess(game.guesses[row], result);
-                ch = game.guesses[row][col];
-                color_idx = result[col];
-            } else if (row == game.current_attempt && col < (int)strlen(game.guesses[row])) {
-                ch = game.guesses[row][col];
-                if (game.invalid_word && strlen(game.guesses[row]) == WORD_LENGTH) {
-                    color_idx = -1; // RED
-                } else {
-                    color_idx = 1; // LIGHTGRAY
-                }
-            }
-            drawCell(x, y, CELL_SIZE, ch, color_idx);
-        }
+//盘面在屏幕上的位置：单词模式居中，多词模式排成最多 8 列的网格，占据 (10, 70) - (990, 425)
+void boardLayout(const GameView* v, int board, int* x0, int* y0, int* cell, int* row_step) {
+    if (v->game.board_count == 1) {
+        *x0 = (SCREEN_WIDTH - WORD_LENGTH * CELL_SIZE) / 2;
+        *y0 = 80;
+        *cell = CELL_SIZE;
+        *row_step = CELL_SIZE + 10;
+        return;
     }
+    int cols = v->game.board_count < 8 ? v->game.board_count : 8;
+    int rows = v->game.board_count / cols;
+    int slot_w = 980 / cols, slot_h = 355 / rows;
+    *row_step = (slot_h - 8) / v->game.max_attempts;
+    *cell = (slot_w - 12) / WORD_LENGTH;
+    if (*cell > *row_step * 9 / 10) *cell = *row_step * 9 / 10;
+    *x0 = 10 + (board % cols) * slot_w + (slot_w - WORD_LENGTH * *cell) / 2;
+    *y0 = 70 + (board / cols) * slot_h;
+}
 
-    settextcolor(BLACK);
-    outtextxy(10, 60, "输入5个大写字母，按回车提交");
-    outtextxy(10, 100, "ESC: 返回主菜单");
+//一行格子占据的区域，左右各扩展 grow_x、向上扩展 grow_y（动画中格子能移动到的范围）
+SceneRect rowArea(const GameView* v, int board, int row, int grow_x, int grow_y) {
+    int x0, y0, cell, row_step;
+    boardLayout(v, board, &x0, &y0, &cell, &row_step);
+    int y = y0 + row * row_step;
+    return { x0 - grow_x, y - grow_y, x0 + WORD_LENGTH * cell + grow_x, y + cell };
+}
 
-    if (game.invalid_word && strlen(game.guesses[game.current_attempt]) == WORD_LENGTH) {
-        settextcolor(RED);
-        settextstyle(20, 0, "SimSun");
-        if (game.hint_message[0] != '\0') {
-            outtextxy(30, 145, game.hint_message);  // 显示实际的错误信息
-        } else {
-            outtextxy(30, 145, "输入的单词不在词典中，请重新输入");  // 保持原有逻辑
-        }
-        settextstyle(24, 0, "SimSun");
-        settextcolor(BLACK);
+//按动画事件开始补间：翻开逐格错开，摇晃整行一起，猜中的一行在翻完之后逐格跳起
+void startEffect(const GameView* v, const Effect* e) {
+    int target = e->board * MAX_GUESSES + e->row;
+    if (e->kind == FX_REVEAL) {
+        animStart(&animator, ANIM_FLIP, target, e->time, 0,
+                  FLIP_MS, FLIP_STAGGER_MS, WORD_LENGTH, rowArea(v, e->board, e->row, 0, 0));
+    } else if (e->kind == FX_SHAKE) {
+        animStart(&animator, ANIM_SHAKE, target, e->time, 0,
+                  SHAKE_MS, 0, 1, rowArea(v, e->board, e->row, SHAKE_PX, 0));
+    } else {
+        uint32_t flip_end = FLIP_MS + (WORD_LENGTH - 1) * FLIP_STAGGER_MS;
+        animStart(&animator, ANIM_BOUNCE, target, e->time, flip_end,
+                  BOUNCE_MS, BOUNCE_STAGGER_MS, WORD_LENGTH, rowArea(v, e->board, e->row, 0, BOUNCE_PX));
     }
+}
 
-    // 提示区域背景
-    if (!game.hint_used || game.hint_message[0] != '\0') {
-        setfillcolor(RGB(240, 248, 255));
-        solidroundrect(680, 430, 980, 480, 10, 10);
-        setlinecolor(LIGHTGRAY);
-        roundrect(680, 430, 980, 480, 10, 10);
+//输入行下方的文字（前缀还能拼出几个词、单词不合法的原因），没有时返回 0；
+//后面还要接着画 game.completions 时返回 2
+int typingMessage(const GameView* v, char* buf, COLORREF* color) {
+    if (v->game.invalid_word && v->game.typed == WORD_LENGTH) {
+        *color = RED;
+        strcpy(buf, v->game.hint_message[0] != '\0' ? v->game.hint_message : "输入的单词不在词典中，请重新输入");
+        return 1;
     }
+    int typed = v->game.game_over ? 0 : v->game.typed;
+    if (typed == 0 || v->game.invalid_word) return 0;
+    uint32_t node = v->game.prefix_nodes[typed];
+    if (node == DAWG_NONE) {
+        *color = RED;
+        strcpy(buf, "词典中没有以此开头的单词");
+        return 1;
+    }
+    if (typed < WORD_LENGTH) {
+        *color = DARKGRAY;
+        if (v->game.completions[0] != '\0') {
+            strcpy(buf, "只能拼出：");
+            return 2;
+        }
+        sprintf(buf, "可能的单词：%u 个", v->game.dict->nodes[node].count);
+        return 1;
+    }
+    return 0;
+}
 
-    if (game.hint_message[0] != '\0') {
-        settextcolor(BLUE);
-        settextstyle(20, 0, "SimSun");
-        outtextxy(700, 450, game.hint_message);
-        settextstyle(24, 0, "SimSun");
-        settextcolor(BLACK);
+const char* mainButtonText(const GameView* v, int i) {
+    static char board_label[32];
+    if (i == 6) return v->menu_hard_mode ? "对抗困难：开" : "对抗困难：关";
+    if (i == 8) {
+        sprintf(board_label, "词数：%d", v->menu_board_count);
+        return board_label;
     }
+    if (i == 9) return v->menu_no_repeat ? "不重复出题：开" : "不重复出题：关";
+    if (i == 11) return v->menu_heat ? "热度键盘：开" : "热度键盘：关";
+    return mainButtons[i].text;
+}
 
-    if (game.game_over) {
-        settextcolor(game.won ? GREEN : RED);
-        char msg[100];
-        if (game.won) {
-            strcpy(msg, "恭喜！你猜对了！");
+//按页面布局场景中的控件，之后每帧只同步外观值
+void buildScene(Scene* s, const GameView* v) {
+    sceneClear(s);
+    sceneAdd(s, WIDGET_PANEL, UI_BACKDROP, 0, 0, SCREEN_WIDTH - 1, SCREEN_HEIGHT - 1, 0);
+    if (v->page == PAGE_MAIN_MENU) {
+        sceneAdd(s, WIDGET_LABEL, UI_DICT_INFO, SCREEN_WIDTH - 320, 675, 300, 30, 0);
+        for (int i = 0; i < MAIN_BUTTON_COUNT; i++) {
+            const Button* b = &mainButtons[i];
+            sceneAdd(s, WIDGET_BUTTON, i, b->x, b->y, b->w, b->h, 1);
+        }
+    } else if (v->page == PAGE_GAME) {
+        sceneAdd(s, WIDGET_LABEL, UI_TITLE, 300, 10, 550, 40, 0);
+        for (int b = 0; b < v->game.board_count; b++) {
+            int x0, y0, cell, row_step;
+            boardLayout(v, b, &x0, &y0, &cell, &row_step);
+            for (int row = 0; row < v->game.max_attempts; row++) {
+                for (int col = 0; col < WORD_LENGTH; col++) {
+                    int id = (b * MAX_GUESSES + row) * WORD_LENGTH + col;
+                    sceneAdd(s, WIDGET_CELL, id, x0 + col * cell, y0 + row * row_step, cell, cell, 0);
+                }
+            }
+        }
+        if (v->game.board_count == 1) {
+            sceneAdd(s, WIDGET_LABEL, UI_HARD_LEGAL, 10, 178, 320, 26, 0);
+            sceneAdd(s, WIDGET_LABEL, UI_TYPING, 20, 143, 320, 26, 0);
+            sceneAdd(s, WIDGET_LABEL, UI_HINT_LETTERS, 10, 215, 320, 100, 0);
         } else {
-            sprintf(msg, "答案是：%s", game.target_word);
+            sceneAdd(s, WIDGET_LABEL, UI_TYPING, 20, 430, 640, 26, 0);
         }
-        outtextxy(250, 560, msg);
-        settextstyle(20, 0, "SimSun");
-        settextcolor(BLUE);
-        outtextxy(500, 560, "按空格键开始下一局");
+        sceneAdd(s, WIDGET_LABEL, UI_HINT_BOX, 680, 430, SCREEN_WIDTH - 681, 50, 0);
+        sceneAdd(s, WIDGET_BUTTON, BTN_HINT, 860, 30, 100, 40, 1);
+        sceneAdd(s, WIDGET_LABEL, UI_GAME_OVER, 240, 550, 750, 150, 0);
+        for (int i = 0; i < v->game.dict->alphabet.size; i++) {
+            if (v->keys[i].used) sceneAdd(s, WIDGET_KEY, i, v->keys[i].x, v->keys[i].y, v->keys[i].w, v->keys[i].h, 1);
+        }
+        sceneAdd(s, WIDGET_BUTTON, BTN_DEL, SCREEN_WIDTH - 100, SCREEN_HEIGHT - 170, 70, 45, 1);
+    } else if (v->page == PAGE_HELP) {
+        sceneAdd(s, WIDGET_BUTTON, BTN_BACK, 400, 500, 200, 50, 1);
+    } else if (v->page == PAGE_STATS) {
+        sceneAdd(s, WIDGET_LABEL, UI_STATS, 100, 110, 800, 480, 0);
+        sceneAdd(s, WIDGET_LABEL, UI_STATS_INFO, 560, 8, 430, 66, 0);
+        sceneAdd(s, WIDGET_BUTTON, BTN_STATS_RANGE, 20, 20, 140, 40, 1);
+        sceneAdd(s, WIDGET_BUTTON, BTN_STATS_MODE, 175, 20, 140, 40, 1);
+        sceneAdd(s, WIDGET_BUTTON, BTN_BACK, 400, 580, 200, 50, 1);
     }
+}
 
-    // 提示按钮
-    int btn_x = 860, btn_y = 30, btn_w = 100, btn_h = 40;
-    COLORREF btn_color;
-    if (!game.hint_used && !game.game_over) {
-        btn_color = GREEN;
-    } else {
-        btn_color = RGB(200, 200, 200); // 灰色表示不可用
+//控件当前的外观值与是否显示，外观值变了才会重画
+uint64_t widgetLook(const GameView* v, const Widget* w, int* visible) {
+    *visible = 1;
+    uint64_t h = SCENE_HASH_INIT;
+    switch (w->kind) {
+    case WIDGET_CELL: {
+        int col = w->id % WORD_LENGTH, row = w->id / WORD_LENGTH % MAX_GUESSES, board = w->id / WORD_LENGTH / MAX_GUESSES;
+        int sym, color;
+        cellState(v, board, row, col, &sym, &color);
+        return (uint64_t)(sym + 1) | (uint64_t)(color + 1) << 8;
     }
-    setfillcolor(btn_color);
-    solidroundrect(btn_x, btn_y, btn_x + btn_w, btn_y + btn_h, 8, 8);
-    setlinecolor(BLACK);
-    roundrect(btn_x, btn_y, btn_x + btn_w, btn_y + btn_h, 8, 8);
-    settextcolor(BLACK);
-    outtextxy(btn_x + 20, btn_y + 10, game.hint_used ? "已使用" : "提示");
-
-    // 分隔线
-    setlinecolor(LIGHTGRAY);
-    line(0, 480, SCREEN_WIDTH, 480);
+    case WIDGET_KEY: {
+        *visible = !v->game.game_over;
+        uint64_t look = 0;
+        for (int b = 0; b < v->game.board_count; b++) {
+            int status = v->game.board_count > 1 && v->game.solved_at[b] >= 0 ? 0 : v->game.key_status[b][w->id];
+            look |= (uint64_t)status << (2 * b);
+        }
+        if (v->menu_heat && v->game.board_count == 1 && look == 0) look = ((uint64_t)v->game.key_heat[w->id] + 1) << 32;
+        return look;
+    }
+    case WIDGET_BUTTON:
+        if (w->id == BTN_HINT) return v->game.hint_used | v->game.game_over << 1;
+        if (w->id == BTN_DEL) *visible = !v->game.game_over;
+        if (w->id == BTN_STATS_RANGE) return v->stats_view.range;
+        if (w->id == BTN_STATS_MODE) return v->stats_view.mode;
+        if (w->id == 6) return v->menu_hard_mode;
+        if (w->id == 8) return v->menu_board_count;
+        if (w->id == 9) return v->menu_no_repeat;
+        if (w->id == 11) return v->menu_heat;
+        return 0;
+    }
+    switch (w->id) {
+    case UI_DICT_INFO:
+        return dictCurrent()->count;
+    case UI_TITLE:
+        return v->game.current_attempt;
+    case UI_HARD_LEGAL:
+        *visible = v->game.hard_mode && v->game.current_attempt > 0 && !v->game.game_over;
+        return v->game.hard_legal_count;
+    case UI_TYPING: {
+        char buf[128];
+        COLORREF color = BLACK;
+        int kind = typingMessage(v, buf, &color);
+        if (!kind) return 0;
+        h = sceneHash(h, &color, sizeof(color));
+        if (kind == 2) h = sceneHash(h, v->game.completions, strlen(v->game.completions));
+        return sceneHash(h, buf, strlen(buf));
+    }
+    case UI_HINT_LETTERS:
+        *visible = v->game.hint_used && v->game.board_count == 1 && v->game.hint_letters[0] >= 0;
+        h = sceneHash(h, v->game.hint_letters, sizeof(v->game.hint_letters));
+        h = sceneHash(h, v->game.hint_shares, sizeof(v->game.hint_shares));
+        return sceneHash(h, &v->game.candidate_count, sizeof(int));
+    case UI_HINT_BOX:
+        h = sceneHash(h, &v->game.hint_used, sizeof(v->game.hint_used));
+        h = sceneHash(h, v->game.hint_message, strlen(v->game.hint_message));
+        h = sceneHash(h, v->game.hint_detail, strlen(v->game.hint_detail));
+        return sceneHash(h, v->game.hint_word, strlen(v->game.hint_word));
+    case UI_GAME_OVER:
+        *visible = v->game.game_over;
+        h = sceneHash(h, &v->game.won, sizeof(v->game.won));
+        return sceneHash(h, v->game.solved_at, sizeof(v->game.solved_at));
+    case UI_STATS: {
+        int count = players.player_count.load();
+        h = sceneHash(h, &v->stats, sizeof(stats));
+        h = sceneHash(h, &v->stats_view.range, sizeof(int) * 2);
+        h = sceneHash(h, &v->stats_view.filtered, sizeof(Statistics));
+        return sceneHash(h, &count, sizeof(count));
+    }
+    case UI_STATS_INFO:
+        h = sceneHash(h, v->stats_view.opener, strlen(v->stats_view.opener));
+        h = sceneHash(h, &v->stats_view.opener_count, sizeof(int));
+        h = sceneHash(h, &v->stats_view.archived, sizeof(uint64_t));
+        return sceneHash(h, &v->stats_view.elapsed_ms, sizeof(float));
+    }
+    return 0;
+}
 
-    // 绘制屏幕键盘
-    if (!game.game_over) {
-        drawKeyboard();
+void syncScene(Scene* s, const GameView* v) {
+    for (int i = 0; i < (int)s->widgets.size(); i++) {
+        int visible;
+        uint64_t look = widgetLook(v, &s->widgets[i], &visible);
+        sceneSetVisible(s, i, visible);
+        sceneSetLook(s, i, look);
     }
 }
 
-void drawHelpScreen(){
-    setfillcolor(RGB(252, 252, 255));
-    fillrectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+//各页面的背景与静态内容
+void drawBackdrop(const GameView* v) {
+    if (v->page == PAGE_MAIN_MENU) {
+        setfillcolor(RGB(245, 245, 255));
+        fillrectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 
-    setfillcolor(RGB(230, 245, 255));
-    fillrectangle(0, 0, SCREEN_WIDTH, 80);
-    settextcolor(BLUE);
-    settextstyle(32, 0, "SimSun");
-    outtextxy(380, 20, "游戏说明");
-    settextstyle(24, 0, "SimSun");
-    settextcolor(BLACK);
+        // 装饰波浪
+        setfillcolor(RGB(230, 240, 255));
+        for (int i = -100; i < SCREEN_WIDTH + 100; i += 80) {
+            fillellipse(i, -30, 100, 60);
+        }
 
-    setfillcolor(WHITE);
-    solidroundrect(80, 100, 920, 500, 15, 15);
-    setlinecolor(LIGHTGRAY);
-    roundrect(80, 100, 920, 500, 15, 15);
+        // 标题带阴影
+        settextcolor(RGB(80, 80, 80));
+        outtextxy(432, 72, "W O R D L E");
+        settextcolor(GREEN);
+        outtextxy(430, 70, "W O R D L E");
 
-    int y = 130;
-    outtextxy(120, y, "1. 猜一个5字母英文单词"); y += 40;
-    outtextxy(120, y, "2. 绿色：字母位置正确"); y += 40;
-    outtextxy(120, y, "3. 黄色：字母存在但位置错"); y += 40;
-    outtextxy(120, y, "4. 灰色：字母不存在"); y += 40;
-    outtextxy(120, y, "5. 你有6次机会"); y += 40;
-    outtextxy(120, y, "6. 困难模式规则："); y += 30;
-    outtextxy(140, y, "   必须包含所有已揭示的黄/绿字母"); y += 30;
-    outtextxy(140, y, "   绿色字母必须保持在原位置"); y += 40;
-    outtextxy(120, y, "7. 单词无效时格子变红"); y += 40;
-    outtextxy(120, y, "8. 每局仅可使用一次提示");
-
-    backBtn = { 400, 500, 200, 50, "返回", PAGE_MAIN_MENU };
-    setfillcolor(RGB(240, 240, 240));
-    solidroundrect(backBtn.x, backBtn.y, backBtn.x + backBtn.w, backBtn.y + backBtn.h, 12, 12);
-    setlinecolor(DARKGRAY);
-    roundrect(backBtn.x, backBtn.y, backBtn.x + backBtn.w, backBtn.y + backBtn.h, 12, 12);
-    settextcolor(BLACK);
-    outtextxy(backBtn.x + 70, backBtn.y + 15, "返回");
-}
+        settextcolor(DARKGRAY);
+        outtextxy(417, 142, "Enjoy yourself!");
+        settextcolor(BLACK);
+        outtextxy(415, 140, "Enjoy yourself!");
 
-void drawStatsScreen() {
-    setfillcolor(RGB(252, 252, 255));
-    fillrectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+        // 按钮背景板
+        setfillcolor(WHITE);
+        solidroundrect(230, 180, 770, 620, 20, 20);
+        setlinecolor(LIGHTGRAY);
+        roundrect(230, 180, 770, 620, 20, 20);
+
+        // 制作信息
+        settextcolor(DARKGRAY);
+        outtextxy(10, 600, "制作者：健雄书院");
+        outtextxy(90, 640, "王同学 陆同学");
+        outtextxy(90, 680, "曾同学 孙同学");
+    } else if (v->page == PAGE_GAME) {
+        setfillcolor(RGB(250, 250, 255));
+        fillrectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+        // 顶部状态栏
+        setfillcolor(RGB(245, 250, 255));
+        fillrectangle(0, 0, SCREEN_WIDTH, 60);
+        setlinecolor(LIGHTGRAY);
+        line(0, 60, SCREEN_WIDTH, 60);
 
-    setfillcolor(RGB(240, 250, 240));
-    fillrectangle(0, 0, SCREEN_WIDTH, 80);
-    settextcolor(GREEN);
-    settextstyle(32, 0, "SimSun");
-    outtextxy(380, 20, "统计数据");
-    settextstyle(24, 0, "SimSun");
-    settextcolor(BLACK);
+        if (v->game.board_count == 1) {
+            outtextxy(10, 60, "输入5个字母，按回车提交");
+            outtextxy(10, 100, "ESC: 返回主菜单");
+        }
 
-    setfillcolor(WHITE);
-    solidroundrect(80, 100, 920, 600, 15, 15);
-    setlinecolor(LIGHTGRAY);
-    roundrect(80, 100, 920, 600, 15, 15);
+        // 分隔线
+        line(0, 480, SCREEN_WIDTH, 480);
+    } else if (v->page == PAGE_HELP) {
+        setfillcolor(RGB(252, 252, 255));
+        fillrectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 
+        setfillcolor(RGB(230, 245, 255));
+        fillrectangle(0, 0, SCREEN_WIDTH, 80);
+        settextcolor(BLUE);
+        settextstyle(32, 0, "SimSun");
+        outtextxy(380, 20, "游戏说明");
+        settextstyle(24, 0, "SimSun");
+        settextcolor(BLACK);
+
+        setfillcolor(WHITE);
+        solidroundrect(80, 100, 920, 500, 15, 15);
+        setlinecolor(LIGHTGRAY);
+        roundrect(80, 100, 920, 500, 15, 15);
+
+        int y = 130;
+        outtextxy(120, y, "1. 猜一个5字母英文单词"); y += 40;
+        outtextxy(120, y, "2. 绿色：字母位置正确"); y += 40;
+        outtextxy(120, y, "3. 黄色：字母存在但位置错"); y += 40;
+        outtextxy(120, y, "4. 灰色：字母不存在"); y += 40;
+        outtextxy(120, y, "5. 你有6次机会"); y += 40;
+        outtextxy(120, y, "6. 困难模式规则："); y += 30;
+        outtextxy(140, y, "   必须包含所有已揭示的黄/绿字母"); y += 30;
+        outtextxy(140, y, "   绿色字母必须保持在原位置"); y += 40;
+        outtextxy(120, y, "7. 单词无效时格子变红"); y += 40;
+        outtextxy(120, y, "8. 每局仅可使用一次提示");
+    } else if (v->page == PAGE_STATS) {
+        setfillcolor(RGB(252, 252, 255));
+        fillrectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
+
+        setfillcolor(RGB(240, 250, 240));
+        fillrectangle(0, 0, SCREEN_WIDTH, 80);
+        settextcolor(GREEN);
+        settextstyle(32, 0, "SimSun");
+        outtextxy(380, 20, "统计数据");
+        settextstyle(24, 0, "SimSun");
+        settextcolor(BLACK);
+
+        setfillcolor(WHITE);
+        solidroundrect(80, 100, 920, 600, 15, 15);
+        setlinecolor(LIGHTGRAY);
+        roundrect(80, 100, 920, 600, 15, 15);
+    }
+}
+
+void drawStatsBody(const GameView* v) {
     int y = 130;
     char buffer[100];
-    sprintf(buffer, "游戏总次数: %d", stats.games_played);
+    sprintf(buffer, "玩家: %s（共 %d 名玩家）", local_player_name, players.player_count.load());
+    outtextxy(480, y, buffer);
+    drawLeaderboards(v, 480, y + 45);
+    // 有筛选时显示从档案算出的统计
+    const Statistics* st = v->stats_view.range || v->stats_view.mode ? &v->stats_view.filtered : &v->stats;
+    sprintf(buffer, "游戏总次数: %d", st->games_played);
     outtextxy(120, y, buffer); y += 40;
-    sprintf(buffer, "获胜次数: %d", stats.games_won);
+    sprintf(buffer, "获胜次数: %d", st->games_won);
     outtextxy(120, y, buffer); y += 40;
-    int win_rate = stats.games_played > 0 ? (stats.games_won * 100 / stats.games_played) : 0;
+    int win_rate = st->games_played > 0 ? (st->games_won * 100 / st->games_played) : 0;
     sprintf(buffer, "胜率: %d%%", win_rate);
     outtextxy(120, y, buffer); y += 40;
-    sprintf(buffer, "当前连胜: %d", stats.current_streak);
+    sprintf(buffer, "当前连胜: %d", st->current_streak);
     outtextxy(120, y, buffer); y += 40;
-    sprintf(buffer, "最大连胜: %d", stats.max_streak);
+    sprintf(buffer, "最大连胜: %d", st->max_streak);
     outtextxy(120, y, buffer); y += 50;
 
     outtextxy(120, y, "猜测成功分布："); y += 40;
     for (int i = 0; i < MAX_ATTEMPTS; i++) {
-        sprintf(buffer, "第%d次：%d", i+1, stats.guess_distribution[i]);
+        sprintf(buffer, "第%d次：%d", i+1, st->guess_distribution[i]);
         outtextxy(140, y, buffer);
         y += 35;
     }
+}
 
-    backBtn = { 400, 580, 200, 50, "返回", PAGE_MAIN_MENU };
-    setfillcolor(RGB(240, 240, 240));
-    solidroundrect(backBtn.x, backBtn.y, backBtn.x + backBtn.w, backBtn.y + backBtn.h, 12, 12);
-    setlinecolor(DARKGRAY);
-    roundrect(backBtn.x, backBtn.y, backBtn.x + backBtn.w, backBtn.y + backBtn.h, 12, 12);
-    settextcolor(BLACK);
-    outtextxy(backBtn.x + 70, backBtn.y + 15, "返回");
+void drawGameOver(const GameView* v) {
+    settextcolor(v->game.won ? GREEN : RED);
+    char msg[100];
+    if (v->game.won) {
+        strcpy(msg, v->game.board_count == 1 ? "恭喜！你猜对了！" : "恭喜！全部猜对！");
+        outtextxy(250, 560, msg);
+    } else if (v->game.board_count == 1) {
+        strcpy(msg, "答案是：");
+        outtextxy(250, 560, msg);
+        outUtf8(250 + textwidth(msg), 560, v->game.target_word[0]);
+    } else {
+        // 列出没猜中的词，每行最多 8 个
+        outtextxy(250, 560, "答案是：");
+        int shown = 0;
+        for (int b = 0; b < v->game.board_count; b++) {
+            if (v->game.solved_at[b] >= 0) continue;
+            outUtf8(250 + (shown % 8) * 85, 600 + (shown / 8) * 35, v->game.target_word[b]);
+            shown++;
+        }
+    }
+    settextstyle(20, 0, "SimSun");
+    settextcolor(BLUE);
+    outtextxy(500, 560, "按空格键开始下一局");
 }
 
-//事件处理
-int handleMouseClick() {
-    MOUSEMSG msg = {0};
-    if (MouseHit()) {
-        msg = GetMouseMsg();
-        if (msg.uMsg == WM_LBUTTONDOWN) {
-            if (current_page == PAGE_MAIN_MENU) {
-                for (int i = 0; i < 5; i++) {
-                    if (msg.x >= mainButtons[i].x && msg.x <= mainButtons[i].x + mainButtons[i].w &&
-                        msg.y >= mainButtons[i].y && msg.y <= mainButtons[i].y + mainButtons[i].h) {
-                        if (i == 0) {
-                            startNewGame(0);
-                            return -1;
-                        } else if (i == 4) {
-                            startNewGame(1);
-                            return -1;
-                        } else {
-                            return mainButtons[i].page_id;
-                        }
-                    }
-                }
-            }
-            else if (current_page == PAGE_GAME) {
-                // 提示按钮
-                int btn_x = 860, btn_y = 30, btn_w = 100, btn_h = 40;
-                if (!game.hint_used && !game.game_over &&
-                    msg.x >= btn_x && msg.x <= btn_x + btn_w &&
-                    msg.y >= btn_y && msg.y <= btn_y + btn_h) {
-                    provideHint();
-                    return -1;
-                }
+void drawButton(const GameView* v, const Widget* w) {
+    int x0 = w->rect.x0, y0 = w->rect.y0, x1 = w->rect.x1, y1 = w->rect.y1;
+    if (w->id == BTN_BACK) {
+        setfillcolor(RGB(240, 240, 240));
+        solidroundrect(x0, y0, x1, y1, 12, 12);
+        setlinecolor(DARKGRAY);
+        roundrect(x0, y0, x1, y1, 12, 12);
+        outtextxy(x0 + 70, y0 + 15, "返回");
+    } else if (w->id == BTN_HINT) {
+        // 灰色表示不可用
+        setfillcolor(!v->game.hint_used && !v->game.game_over ? GREEN : RGB(200, 200, 200));
+        solidroundrect(x0, y0, x1, y1, 8, 8);
+        roundrect(x0, y0, x1, y1, 8, 8);
+        outtextxy(x0 + 20, y0 + 10, v->game.hint_used ? "已使用" : "提示");
+    } else if (w->id == BTN_STATS_RANGE || w->id == BTN_STATS_MODE) {
+        const char* text = w->id == BTN_STATS_RANGE ? STATS_RANGE_NAMES[v->stats_view.range]
+                                                    : STATS_MODE_NAMES[v->stats_view.mode];
+        setfillcolor(WHITE);
+        solidroundrect(x0, y0, x1, y1, 8, 8);
+        roundrect(x0, y0, x1, y1, 8, 8);
+        outtextxy(x0 + (x1 - x0 - textwidth(text)) / 2, y0 + 8, text);
+    } else if (w->id == BTN_DEL) {
+        setfillcolor(LIGHTRED);
+        solidroundrect(x0, y0, x1, y1, 8, 8);
+        roundrect(x0, y0, x1, y1, 8, 8);
+        outtextxy(x0 + 10, y0 + 10, "DEL");
+    } else {
+        // 主菜单：左列开始游戏，右列其它页面
+        int i = w->id;
+        COLORREF btnColor = (i == 0 || i == 4 || i == 5 || i == 7) ? RGB(220, 240, 220) : LIGHTGRAY;
+        setfillcolor(btnColor);
+        solidroundrect(x0, y0, x1, y1, 10, 10);
+        roundrect(x0, y0, x1, y1, 10, 10);
+        const char* text = mainButtonText(v, i);
+        outtextxy(x0 + (x1 - x0 - textwidth(text)) / 2, y0 + 15, text);
+    }
+}
 
-                // 屏幕键盘点击
-                if (!game.game_over && game.current_attempt < MAX_ATTEMPTS) {
-                    for (int i = 0; i < 26; i++) {
-                        if (keys[i].ch == 0) continue;
-                        if (msg.x >= keys[i].x && msg.x <= keys[i].x + keys[i].w &&
-                            msg.y >= keys[i].y && msg.y <= keys[i].y + keys[i].h) {
-                            int len = strlen(game.guesses[game.current_attempt]);
-                            if (len < WORD_LENGTH) {
-                                game.guesses[game.current_attempt][len] = keys[i].ch;
-                                game.guesses[game.current_attempt][len + 1] = '\0';
-                                game.invalid_word = 0;
-                            }
-                            return -1;
-                        }
-                    }
-                    // 退格键：
-                    int del_x1 = SCREEN_WIDTH - 100, del_x2 = SCREEN_WIDTH - 30;
-                    int del_y1 = SCREEN_HEIGHT - 170, del_y2 = SCREEN_HEIGHT - 125;
-                    if (msg.x >= del_x1 && msg.x <= del_x2 &&
-                        msg.y >= del_y1 && msg.y <= del_y2) {
-                        int len = strlen(game.guesses[game.current_attempt]);
-                        if (len > 0) {
-                            game.guesses[game.current_attempt][len - 1] = '\0';
-                            game.invalid_word = 0;
-                        }
-                        return -1;
-                    }
-                }
+void drawLabel(const GameView* v, const Widget* w) {
+    char buf[128];
+    switch (w->id) {
+    case UI_DICT_INFO:
+        // 当前词库规模（修改 words.txt 后会自动更新）
+        sprintf(buf, "词库：%d 个单词", dictCurrent()->count);
+        settextcolor(DARKGRAY);
+        outtextxy(SCREEN_WIDTH - textwidth(buf) - 20, 680, buf);
+        break;
+    case UI_TITLE: {
+        const char* name = "WORDLE";
+        if (v->game.mode == MODE_ABSURDLE) name = "ABSURDLE";
+        else if (v->game.mode == MODE_DAILY) name = "DAILY";
+        else if (v->game.board_count == 2) name = "DORDLE";
+        else if (v->game.board_count == 4) name = "QUORDLE";
+        else if (v->game.board_count == 8) name = "OCTORDLE";
+        else if (v->game.board_count == 16) name = "SEDECORDLE";
+        sprintf(buf, "%s - 第 %d / %d 轮", name, v->game.current_attempt + 1, v->game.max_attempts);
+        outtextxy(v->game.board_count == 1 ? 410 : 360, 20, buf);
+        break;
+    }
+    case UI_HARD_LEGAL:
+        sprintf(buf, "困难模式可用单词：%d 个", v->game.hard_legal_count);
+        settextstyle(20, 0, "SimSun");
+        settextcolor(DARKGRAY);
+        outtextxy(10, 180, buf);
+        break;
+    case UI_TYPING: {
+        COLORREF color;
+        int kind = typingMessage(v, buf, &color);
+        if (kind) {
+            settextstyle(20, 0, "SimSun");
+            settextcolor(color);
+            outtextxy(30, w->rect.y0 + 2, buf);
+            if (kind == 2) outUtf8(30 + textwidth(buf), w->rect.y0 + 2, v->game.completions);
+        }
+        break;
+    }
+    case UI_HINT_LETTERS: {
+        // 各位置在候选中最常见的字母，占比越高底色越深
+        settextstyle(20, 0, "SimSun");
+        settextcolor(DARKGRAY);
+        sprintf(buf, "候选 %d 个，各位置最常见：", v->game.candidate_count);
+        outtextxy(w->rect.x0, w->rect.y0, buf);
+        for (int p = 0; p < WORD_LENGTH; p++) {
+            int x = w->rect.x0 + 10 + p * 60, y = w->rect.y0 + 30;
+            int share = v->game.hint_shares[p];
+            setfillcolor(RGB(255 - share, 255 - share / 3, 255 - share));
+            solidroundrect(x, y, x + 52, y + 62, 8, 8);
+            setlinecolor(LIGHTGRAY);
+            roundrect(x, y, x + 52, y + 62, 8, 8);
+            settextstyle(24, 0, "SimSun");
+            settextcolor(BLACK);
+            const char* sym = v->game.dict->alphabet.symbols[v->game.hint_letters[p]];
+            outUtf8(x + (52 - utf8Width(sym)) / 2, y + 6, sym);
+            settextstyle(14, 0, "SimSun");
+            settextcolor(DARKGRAY);
+            sprintf(buf, "%d%%", share);
+            outtextxy(x + (52 - textwidth(buf)) / 2, y + 40, buf);
+        }
+        break;
+    }
+    case UI_HINT_BOX:
+        // 提示区域背景
+        if (!v->game.hint_used || v->game.hint_message[0] != '\0') {
+            setfillcolor(RGB(240, 248, 255));
+            solidroundrect(680, 430, 980, 480, 10, 10);
+            setlinecolor(LIGHTGRAY);
+            roundrect(680, 430, 980, 480, 10, 10);
+        }
+        if (v->game.hint_message[0] != '\0') {
+            settextcolor(BLUE);
+            settextstyle(20, 0, "SimSun");
+            int y = v->game.hint_detail[0] != '\0' ? 438 : 450;
+            outtextxy(700, y, v->game.hint_message);
+            if (v->game.hint_word[0] != '\0') {
+                outUtf8(700 + textwidth(v->game.hint_message), y, v->game.hint_word);
             }
-            else if (current_page == PAGE_HELP || current_page == PAGE_STATS) {
-                if (msg.x >= backBtn.x && msg.x <= backBtn.x + backBtn.w &&
-                    msg.y >= backBtn.y && msg.y <= backBtn.y + backBtn.h) {
-                    return PAGE_MAIN_MENU;
-                }
+            if (v->game.hint_detail[0] != '\0') {
+                settextcolor(DARKGRAY);
+                settextstyle(14, 0, "SimSun");
+                outtextxy(700, 461, v->game.hint_detail);
             }
         }
+        break;
+    case UI_GAME_OVER:
+        drawGameOver(v);
+        break;
+    case UI_STATS:
+        drawStatsBody(v);
+        break;
+    case UI_STATS_INFO: {
+        const StatsView* sv = &v->stats_view;
+        settextstyle(20, 0, "SimSun");
+        settextcolor(DARKGRAY);
+        if (sv->opener_count > 0) {
+            strcpy(buf, "最常用开局：");
+            outtextxy(w->rect.x0, 14, buf);
+            int x = w->rect.x0 + textwidth(buf);
+            outUtf8(x, 14, sv->opener);
+            sprintf(buf, "（%d 局）", sv->opener_count);
+            outtextxy(x + utf8Width(sv->opener), 14, buf);
+        } else {
+            outtextxy(w->rect.x0, 14, "没有符合条件的对局");
+        }
+        settextstyle(14, 0, "SimSun");
+        sprintf(buf, "档案 %llu 局，统计用时 %.1f ms", (unsigned long long)sv->archived, sv->elapsed_ms);
+        outtextxy(w->rect.x0, 44, buf);
+        break;
+    }
     }
-    return -1;
 }
 
-void handleGameInput() {
-    ExMessage m;
-    while (peekmessage(&m, EM_KEY)) {
-        if (m.message != WM_KEYDOWN) continue;
-        if (m.vkcode == VK_ESCAPE) {
-            current_page = PAGE_MAIN_MENU;
-            return;
-        }
+void paintWidget(const GameView* v, const Widget* w) {
+    settextstyle(24, 0, "SimSun");
+    settextcolor(BLACK);
+    setlinecolor(BLACK);
+    switch (w->kind) {
+    case WIDGET_PANEL:
+        drawBackdrop(v);
+        break;
+    case WIDGET_LABEL:
+        drawLabel(v, w);
+        break;
+    case WIDGET_CELL:
+        drawAnimatedCell(v, w);
+        break;
+    case WIDGET_KEY:
+        drawKey(v, w->id);
+        break;
+    case WIDGET_BUTTON:
+        drawButton(v, w);
+        break;
     }
+    settextstyle(24, 0, "SimSun");
+}
 
-    static bool keyWasPressed[256] = {false};
-
-    if (GetAsyncKeyState(VK_RETURN) & 0x8000) {
-        if (!keyWasPressed[VK_RETURN]) {
-            keyWasPressed[VK_RETURN] = true;
-            if (!game.game_over && game.current_attempt < MAX_ATTEMPTS) {
-                int len = (int)strlen(game.guesses[game.current_attempt]);
-                if (len == WORD_LENGTH) {
-                    if (!isValidWord(game.guesses[game.current_attempt])) {
-                        game.invalid_word = 1;
-                        game.hint_message[0] = '\0';
-                    } else if (!satisfiesHardMode(game.guesses[game.current_attempt])) {
-                        game.invalid_word = 1;
-                        strcpy(game.hint_message, "困难模式：必须使用已揭示的线索！");
-                    } else {
-                        game.invalid_word = 0;
-                        game.hint_message[0] = '\0';
-                        if (strcmp(game.guesses[game.current_attempt], game.target_word) == 0) {
-                            game.won = 1;
-                            game.game_over = 1;
-                        }
-                        game.current_attempt++;
-                        if (game.current_attempt >= MAX_ATTEMPTS) {
-                            game.game_over = 1;
-                        }
-                        if (game.game_over) {
-                            updateStats();
-                        } else {
-                            updateKeyboardStatus();
-                        }
-                    }
-                }
-            }
-        }
+//同步外观后只重画脏区：每块脏区裁剪后按层次重画与之相交的控件，再只把这块送到窗口。
+//返回仍在播放的动画个数
+int renderScene(const GameView* v, const std::vector<Effect>& effects) {
+    frame_time = GetTickCount();
+    if (scene_layout != v->layout) {
+        scene_layout = v->layout;
+        buildScene(&scene, v);
+        animClear(&animator, &scene);
+    }
+    for (const Effect& e : effects) {
+        if (e.layout == v->layout) startEffect(v, &e);
+    }
+    int animating = animStep(&animator, &scene, frame_time);
+    syncScene(&scene, v);
+
+    static std::vector<SceneRect> dirty;
+    static std::vector<int> hits;
+    sceneTakeDirty(&scene, dirty);
+    for (const SceneRect& r : dirty) {
+        HRGN rgn = CreateRectRgn(r.x0, r.y0, r.x1 + 1, r.y1 + 1);
+        setcliprgn(rgn);
+        DeleteObject(rgn);
+        sceneQuery(&scene, r, hits);
+        for (int i : hits) paintWidget(v, &scene.widgets[i]);
+    }
+    setcliprgn(NULL);
+    for (const SceneRect& r : dirty) {
+        FlushBatchDraw(r.x0, r.y0, r.x1, r.y1);
+    }
+    return animating;
+}
+
+//排行榜上的分数按榜的种类显示
+void formatBoardScore(int board, int64_t score, char* out) {
+    if (board == BOARD_WIN_RATE) {
+        sprintf(out, "%d.%02d%%", (int)(score / 100), (int)(score % 100));
+    } else if (board == BOARD_MAX_STREAK) {
+        sprintf(out, "%d 连胜", (int)score);
     } else {
-        keyWasPressed[VK_RETURN] = false;
+        sprintf(out, "平均 %.2f 次", -score / 1000.0);
     }
+}
 
-    if (GetAsyncKeyState(VK_SPACE) & 0x8000) {
-        if (!keyWasPressed[VK_SPACE]) {
-            keyWasPressed[VK_SPACE] = true;
-            if (game.game_over) {
-                startNewGame(game.hard_mode);
+void drawLeaderboards(const GameView* v, int x, int y) {
+    const char* names[BOARD_COUNT] = { "胜率榜", "连胜榜", "猜测次数榜" };
+    char buffer[100], score[32];
+    for (int b = 0; b < BOARD_COUNT; b++) {
+        const RankView* r = &v->ranks[b];
+        const RankEntry* top = r->top;
+        settextstyle(24, 0, "SimSun");
+        settextcolor(BLACK);
+        if (r->rank > 0) sprintf(buffer, "%s  排名: %d / %d", names[b], r->rank, r->size);
+        else sprintf(buffer, "%s  未上榜（共 %d 人）", names[b], r->size);
+        outtextxy(x, y, buffer);
+        y += 32;
+
+        settextstyle(20, 0, "SimSun");
+        for (int i = 0; i < r->count; i++) {
+            formatBoardScore(b, top[i].score, score);
+            settextcolor(top[i].player_id == local_player_id ? GREEN : DARKGRAY);
+            if (top[i].player_id == local_player_id) {
+                sprintf(buffer, "%d. %s  %s", i + 1, local_player_name, score);
+            } else {
+                sprintf(buffer, "%d. 玩家 #%04X  %s", i + 1, (unsigned)(top[i].player_id & 0xFFFF), score);
             }
+            outtextxy(x + 20, y, buffer);
+            y += 26;
         }
-    } else {
-        keyWasPressed[VK_SPACE] = false;
+        y += 18;
+    }
+    settextstyle(24, 0, "SimSun");
+    settextcolor(BLACK);
+}
+
+//线程间传递
+ViewSnapshot viewCurrent(SpscLatest<ViewSnapshot>* slot) {
+    return latestRead(slot);
+}
+
+//把逻辑线程的当前状态复制成一份快照发布，再送出本批命令产生的动画事件
+void publishView() {
+    auto v = std::make_shared<GameView>();
+    v->layout = layout_id;
+    v->page = current_page;
+    v->game = game;
+    memcpy(v->keys, keys, sizeof(keys));
+    v->menu_hard_mode = menu_hard_mode;
+    v->menu_board_count = menu_board_count;
+    v->menu_no_repeat = menu_no_repeat;
+    v->menu_heat = menu_heat;
+    v->stats = stats;
+    v->stats_view = stats_view;
+    for (int b = 0; b < BOARD_COUNT; b++) {
+        const Leaderboard* lb = &leaderboards.boards[b];
+        RankView* r = &v->ranks[b];
+        r->rank = leaderboardRank(lb, local_player_id);
+        r->size = leaderboardSize(lb);
+        r->count = leaderboardPage(lb, 1, LEADERBOARD_TOP, r->top);
     }
+    ViewSnapshot snap = std::move(v);
+    latestPublish(&render_view, snap);
+    latestPublish(&input_view, snap);
+    // 队列满时丢掉，只是少一段动画
+    for (const Effect& e : pending_effects) spscPush(&effect_queue, e);
+    pending_effects.clear();
+}
 
-    if (GetAsyncKeyState(VK_BACK) & 0x8000) {
-        if (!keyWasPressed[VK_BACK]) {
-            keyWasPressed[VK_BACK] = true;
-            if (!game.game_over && game.current_attempt < MAX_ATTEMPTS) {
-                int len = (int)strlen(game.guesses[game.current_attempt]);
-                if (len > 0) {
-                    game.guesses[game.current_attempt][len - 1] = '\0';
-                    game.invalid_word = 0;
-                }
-            }
+void emitEffect(int kind, int board, int row) {
+    pending_effects.push_back({ kind, layout_id, board, row, (uint32_t)GetTickCount() });
+}
+
+//一行的动画发给所有还没猜中的盘面（在更新 solved_at 之前调用，本行猜中的盘面也要动）
+void emitRowEffect(int kind, int row) {
+    for (int b = 0; b < game.board_count; b++) {
+        if (game.solved_at[b] < 0) emitEffect(kind, b, row);
+    }
+}
+
+//换页面或开新局：布局编号加一，输入与绘制线程看到新快照时重新布局
+void setPage(int page) {
+    current_page = page;
+    layout_id++;
+}
+
+//事件发生后调用：attempt 等字段取自当前对局，TEL_GUESS 带上刚提交那一行在各盘面的反馈
+void emitTelemetry(int kind, const char* word) {
+    TelemetryEvent e;
+    memset(&e, 0, sizeof(e));
+    e.session = session_id;
+    e.time_ms = GetTickCount();
+    e.kind = (uint8_t)kind;
+    e.mode = (uint8_t)game.mode;
+    e.attempt = (uint8_t)game.current_attempt;
+    e.board_count = (uint8_t)game.board_count;
+    if (word) strncpy(e.word, word, sizeof(e.word) - 1);
+    if (kind == TEL_GUESS) {
+        int row = game.current_attempt - 1;
+        for (int b = 0; b < game.board_count; b++) {
+            // 之前就已猜中的盘面不再打分，记为全绿
+            e.patterns[b] = game.solved_at[b] >= 0 && game.solved_at[b] < row ? PATTERN_ALL_GREEN : game.patterns[b][row];
         }
-    } else {
-        keyWasPressed[VK_BACK] = false;
-    }
-
-    for (int vk = 'A'; vk <= 'Z'; vk++) {
-        if (GetAsyncKeyState(vk) & 0x8000) {
-            if (!keyWasPressed[vk]) {
-                keyWasPressed[vk] = true;
-                if (!game.game_over && game.current_attempt < MAX_ATTEMPTS) {
-                    int len = (int)strlen(game.guesses[game.current_attempt]);
-                    if (len < WORD_LENGTH) {
-                        game.guesses[game.current_attempt][len] = (char)vk;
-                        game.guesses[game.current_attempt][len + 1] = '\0';
-                        game.invalid_word = 0;
-                    }
-                }
+    }
+    telemetryPush(&telemetry, &e);
+}
+
+//事件处理
+//输入线程：阻塞等消息，点击按最新快照的布局做网格检测，转成命令交给逻辑线程。
+//按住不放的自动重复不算新的按键，与原来按边沿检测按键的行为一致
+void inputLoop() {
+    Scene hits;
+    sceneInit(&hits, SCREEN_WIDTH, SCREEN_HEIGHT);
+    uint64_t hits_layout = 0;
+    std::vector<SceneRect> discard;
+    for (;;) {
+        ExMessage m = getmessage(EM_MOUSE | EM_KEY | EM_CHAR);
+        Command c = { CMD_CHAR, 0, 0, 0 };
+        if (m.message == WM_LBUTTONDOWN) {
+            ViewSnapshot v = viewCurrent(&input_view);
+            if (v->layout != hits_layout) {
+                buildScene(&hits, v.get());
+                hits_layout = v->layout;
             }
+            syncScene(&hits, v.get());   // 控件显隐随状态变化（如结束后键盘隐藏）
+            sceneTakeDirty(&hits, discard);
+            int hit = sceneHitTest(&hits, m.x, m.y);
+            if (hit < 0) continue;
+            c = { CMD_CLICK, hits.widgets[hit].kind, hits.widgets[hit].id, v->layout };
+        } else if (m.message == WM_CHAR) {
+            c.id = (unsigned char)m.ch;
+        } else if (m.message == WM_KEYDOWN && !m.prevdown) {
+            c = { CMD_KEY, 0, m.vkcode, 0 };
         } else {
-            keyWasPressed[vk] = false;
+            continue;
         }
+        // 逻辑线程卡在很慢的操作上、队列又已塞满时丢掉这次输入
+        spscPush(&input_queue, c);
     }
+}
 
-    for (int vk = 'a'; vk <= 'z'; vk++) {
-        if (GetAsyncKeyState(vk) & 0x8000) {
-            if (!keyWasPressed[vk]) {
-                keyWasPressed[vk] = true;
-                if (!game.game_over && game.current_attempt < MAX_ATTEMPTS) {
-                    int len = (int)strlen(game.guesses[game.current_attempt]);
-                    if (len < WORD_LENGTH) {
-                        game.guesses[game.current_attempt][len] = (char)(vk - 32);
-                        game.guesses[game.current_attempt][len + 1] = '\0';
-                        game.invalid_word = 0;
-                    }
-                }
-            }
-        } else {
-            keyWasPressed[vk] = false;
+//逻辑线程：一次取完队列里的命令再发布快照，连续输入时不必每个字母都复制一遍状态
+void logicLoop() {
+    Command c;
+    while (current_page != PAGE_EXIT) {
+        spscWait(&input_queue);
+        while (current_page != PAGE_EXIT && spscPop(&input_queue, &c)) handleCommand(&c);
+        publishView();
+    }
+}
+
+void handleCommand(const Command* c) {
+    if (c->type == CMD_CLICK) {
+        if (c->layout == layout_id) handleClick(c->kind, c->id);
+    } else if (c->type == CMD_CHAR) {
+        // 字母走 WM_CHAR，由输入法/键盘布局决定输入的是哪个字母，非英文字母也能直接输入
+        if (current_page == PAGE_GAME) appendLetter(charToSymbol((unsigned char)c->id));
+    } else {
+        handleKey(c->id);
+    }
+}
+
+//提示可能要现算开局库：先发布“计算中”的快照，计算期间界面照常刷新
+void requestHint() {
+    if (game.hint_used || game.game_over) return;
+    char before[sizeof(game.hint_message)];
+    strcpy(before, game.hint_message);
+    strcpy(game.hint_message, "正在计算提示……");
+    publishView();
+    provideHint();
+    if (!game.hint_used) strcpy(game.hint_message, before);
+    else emitTelemetry(TEL_HINT, game.hint_word);
+}
+
+//点击按命中的控件分发
+void handleClick(int kind, int id) {
+    if (kind == WIDGET_KEY) {
+        appendLetter(id);
+        return;
+    }
+    switch (id) {
+    case BTN_BACK:
+        setPage(PAGE_MAIN_MENU);
+        break;
+    case BTN_HINT:
+        requestHint();
+        break;
+    case BTN_DEL:
+        removeLetter();
+        break;
+    case BTN_STATS_RANGE:
+        stats_view.range = (stats_view.range + 1) % STATS_RANGE_COUNT;
+        refreshStatsView();
+        break;
+    case BTN_STATS_MODE:
+        stats_view.mode = (stats_view.mode + 1) % STATS_MODE_COUNT;
+        refreshStatsView();
+        break;
+    case 0:
+        startNewGame(0, MODE_CLASSIC, 1);
+        break;
+    case 4:
+        startNewGame(1, MODE_CLASSIC, 1);
+        break;
+    case 5:
+        startNewGame(menu_hard_mode, MODE_ABSURDLE, 1);
+        break;
+    case 6:
+        menu_hard_mode = !menu_hard_mode;
+        break;
+    case 7:
+        startNewGame(0, MODE_MULTI, menu_board_count);
+        break;
+    case 8:
+        menu_board_count = menu_board_count >= MAX_BOARDS ? 2 : menu_board_count * 2;
+        break;
+    case 9:
+        menu_no_repeat = !menu_no_repeat;
+        break;
+    case 10:
+        startNewGame(0, MODE_DAILY, 1);
+        break;
+    case 11:
+        menu_heat = !menu_heat;
+        break;
+    default:
+        if (mainButtons[id].page_id == PAGE_STATS) refreshStatsView();
+        setPage(mainButtons[id].page_id);
+        break;
+    }
+}
+
+void handleKey(int vk) {
+    if (current_page != PAGE_GAME) return;
+    if (vk == VK_ESCAPE) {
+        setPage(PAGE_MAIN_MENU);
+    } else if (vk == VK_RETURN) {
+        if (!game.game_over && game.current_attempt < game.max_attempts && game.typed == WORD_LENGTH) {
+            submitGuess();
+        }
+    } else if (vk == VK_SPACE) {
+        if (game.game_over) {
+            // 每日一题一天只有一个，再来一局改为随机出题
+            startNewGame(game.hard_mode, game.mode == MODE_DAILY ? MODE_CLASSIC : game.mode, game.board_count);
         }
+    } else if (vk == VK_BACK) {
+        removeLetter();
     }
 }
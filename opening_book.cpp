@@ -0,0 +1,120 @@
+#include "opening_book.h"
+#include "solver.h"
+#include <stdio.h>
+#include <string.h>
+
+static const char OPENING_MAGIC[8] = { 'W', 'O', 'P', 'E', 'N', 'B', 'K', '1' };
+
+struct OpeningFile {
+    char magic[8];
+    uint64_t dict_hash;
+    int32_t hard_mode;
+    int32_t count;
+    uint32_t first;
+    uint32_t second[PATTERN_COUNT];
+};
+
+void openingBuild(OpeningBook* book, const Dictionary* d, int hard_mode) {
+    const Strategy* st = findStrategy("entropy");
+    SolverScratch scratch;
+    solverInitScratch(&scratch, d, 0);
+
+    int n = d->count;
+    std::vector<uint32_t> all(n), grouped(n);
+    std::vector<uint8_t> patterns(n);
+    for (int i = 0; i < n; i++) all[i] = (uint32_t)i;
+
+    book->dict_hash = d->hash;
+    book->hard_mode = hard_mode;
+    book->count = n;
+    SolverState s = { d, hard_mode, 0, nullptr, nullptr, all.data(), n };
+    book->first = n > 0 ? st->pick(&s, &scratch) : OPENING_NONE;
+    for (int p = 0; p < PATTERN_COUNT; p++) book->second[p] = OPENING_NONE;
+    if (n == 0) return;
+
+    // 按第一步的反馈分组，每组各算一次第二步
+    const uint8_t* first = dictWord(d, book->first);
+    int bucket_start[PATTERN_COUNT + 1];
+    partitionByPattern(d, first, all.data(), n, patterns.data(), grouped.data(), bucket_start);
+    for (int p = 0; p < PATTERN_COUNT; p++) {
+        int size = bucket_start[p + 1] - bucket_start[p];
+        if (size == 0) continue;
+        if (p == PATTERN_ALL_GREEN) {
+            book->second[p] = book->first;
+            continue;
+        }
+        uint8_t pattern = (uint8_t)p;
+        SolverState s2 = { d, hard_mode, 1, first, &pattern, grouped.data() + bucket_start[p], size };
+        book->second[p] = st->pick(&s2, &scratch);
+    }
+}
+
+int openingSave(const OpeningBook* book, const char* path) {
+    OpeningFile f;
+    memset(&f, 0, sizeof(f));
+    memcpy(f.magic, OPENING_MAGIC, sizeof(f.magic));
+    f.dict_hash = book->dict_hash;
+    f.hard_mode = book->hard_mode;
+    f.count = book->count;
+    f.first = book->first;
+    memcpy(f.second, book->second, sizeof(f.second));
+
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) return 0;
+    int ok = fwrite(&f, sizeof(f), 1, fp) == 1;
+    ok = fclose(fp) == 0 && ok;
+    if (!ok) {
+        remove(tmp);
+        return 0;
+    }
+    if (rename(tmp, path) != 0) {
+        remove(path);   // Windows 下 rename 不能覆盖已有文件
+        if (rename(tmp, path) != 0) return 0;
+    }
+    return 1;
+}
+
+int openingLoad(OpeningBook* book, const char* path, const Dictionary* d, int hard_mode) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return 0;
+    OpeningFile f;
+    int ok = fread(&f, sizeof(f), 1, fp) == 1;
+    fclose(fp);
+    if (!ok || memcmp(f.magic, OPENING_MAGIC, sizeof(f.magic)) != 0) return 0;
+    // 词库内容或模式变了，文件作废
+    if (f.dict_hash != d->hash || f.count != d->count || f.hard_mode != hard_mode) return 0;
+    if (f.first >= (uint32_t)d->count) return 0;
+    for (int p = 0; p < PATTERN_COUNT; p++) {
+        if (f.second[p] != OPENING_NONE && f.second[p] >= (uint32_t)d->count) return 0;
+    }
+
+    book->dict_hash = f.dict_hash;
+    book->hard_mode = f.hard_mode;
+    book->count = f.count;
+    book->first = f.first;
+    memcpy(book->second, f.second, sizeof(book->second));
+    return 1;
+}
+
+int openingLoadOrBuild(OpeningBook* book, const char* path, const Dictionary* d, int hard_mode) {
+    if (openingLoad(book, path, d, hard_mode)) return 1;
+    openingBuild(book, d, hard_mode);
+    openingSave(book, path);
+    return 0;
+}
+
+uint32_t openingLookup(const OpeningBook* book, const Dictionary* d, int attempt,
+                       const uint8_t* guesses, const uint8_t* patterns) {
+    if (book->dict_hash != d->hash || book->count != d->count || book->first == OPENING_NONE) return OPENING_NONE;
+    if (attempt == 0) return book->first;
+    if (attempt == 1 && memcmp(guesses, dictWord(d, book->first), WORD_LENGTH) == 0) {
+        return book->second[patterns[0]];
+    }
+    return OPENING_NONE;
+}
+
+const char* openingDefaultPath(int hard_mode) {
+    return hard_mode ? "opening_hard.bin" : "opening.bin";
+}
@@ -0,0 +1,32 @@
+#pragma once
+#include "dictionary.h"
+#include "scoring.h"
+
+const uint32_t OPENING_NONE = 0xFFFFFFFFu;
+
+//开局库：同一词库、同一模式下熵策略的前两步总是一样的，算一次存进文件。
+//dict_hash 与 hard_mode 不一致的文件视为过期，重新生成并覆盖
+struct OpeningBook {
+    uint64_t dict_hash;
+    int hard_mode;
+    int count;                        // 生成时词库的单词数
+    uint32_t first;                   // 第一步的词下标
+    uint32_t second[PATTERN_COUNT];   // 第一步得到反馈 p 后的第二步，不会出现的反馈为 OPENING_NONE
+};
+
+//用熵策略生成开局库
+void openingBuild(OpeningBook* book, const Dictionary* d, int hard_mode);
+
+int openingSave(const OpeningBook* book, const char* path);
+//读取开局库，文件不存在、损坏或与词库/模式不匹配时返回 0
+int openingLoad(OpeningBook* book, const char* path, const Dictionary* d, int hard_mode);
+//读取开局库，不可用时重新生成并写回 path，返回 1 表示是从文件读到的
+int openingLoadOrBuild(OpeningBook* book, const char* path, const Dictionary* d, int hard_mode);
+
+//查开局库：attempt 为已猜次数，guesses（每行 WORD_LENGTH 个字母）/patterns 为已猜的各行。
+//第一步直接给出；第二步只有第一步走的正是库里的词时才给出；词库不符或超出两步时返回 OPENING_NONE
+uint32_t openingLookup(const OpeningBook* book, const Dictionary* d, int attempt,
+                       const uint8_t* guesses, const uint8_t* patterns);
+
+//默认文件名，普通与困难模式各一个
+const char* openingDefaultPath(int hard_mode);
@@ -0,0 +1,489 @@
+#include "player_stats.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#if defined(_WIN32)
+#include <io.h>
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char LEGACY_MAGIC[4] = { 'W', 'P', 'L', 'S' };     // 版本 1：记录数 + 顺序写入的记录
+const int LEGACY_VERSION = 1;
+static const char STATS_FILE_MAGIC[8] = { 'W', 'P', 'L', 'S', 'M', 'A', 'P', '2' };
+
+struct PlayerRecord {
+    uint64_t player_id;
+    Statistics stats;
+};
+static_assert(sizeof(PlayerRecord) % sizeof(uint64_t) == 0, "记录按 8 字节算校验和");
+
+struct StatsFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t capacity;                  // 每个槽的记录数
+    uint32_t reserved[11];
+};
+
+struct StatsSlotHeader {
+    uint64_t seq;                       // 每保存一次加一，0 表示从没写过
+    uint32_t count;
+    uint32_t checksum;                  // 序号、记录数与 count 条记录的校验和
+};
+static_assert(sizeof(StatsFileHeader) == 64 && sizeof(StatsSlotHeader) == 16, "文件布局");
+
+static uint64_t mixId(uint64_t id) {
+    id ^= id >> 33;
+    id *= 0xFF51AFD7ED558CCDull;
+    id ^= id >> 33;
+    return id;
+}
+
+void playerStatsInit(PlayerStatsStore* store) {
+    for (int s = 0; s < STATS_SHARDS; s++) store->shards[s].store(nullptr);
+    store->player_count.store(0);
+    store->version.store(0);
+    store->saved_version = 0;
+    memset(&store->file, 0, sizeof(store->file));
+    store->file.slot = -1;
+    store->autosave_running.store(false);
+}
+
+static void unmapFile(StatsFile* f);
+
+void playerStatsFree(PlayerStatsStore* store) {
+    playerStatsStopAutosave(store);
+    unmapFile(&store->file);
+    for (int s = 0; s < STATS_SHARDS; s++) {
+        StatsSegment* seg = store->shards[s].exchange(nullptr);
+        while (seg) {
+            StatsSegment* next = seg->next.load();
+            delete seg;
+            seg = next;
+        }
+    }
+    store->player_count.store(0);
+}
+
+static StatsSegment* newSegment() {
+    StatsSegment* seg = new StatsSegment();   // 值初始化，所有槽位清零
+    seg->next.store(nullptr, std::memory_order_relaxed);
+    return seg;
+}
+
+//取得 link 指向的段，为空且允许创建时用 CAS 接上一个新段（抢输了就用别人接上的）
+static StatsSegment* segmentAt(std::atomic<StatsSegment*>* link, int create) {
+    StatsSegment* seg = link->load(std::memory_order_acquire);
+    if (seg || !create) return seg;
+    StatsSegment* fresh = newSegment();
+    if (link->compare_exchange_strong(seg, fresh, std::memory_order_acq_rel)) return fresh;
+    delete fresh;
+    return seg;
+}
+
+PlayerStats* playerStatsFind(PlayerStatsStore* store, uint64_t player_id, int create) {
+    uint64_t h = mixId(player_id);
+    std::atomic<StatsSegment*>* link = &store->shards[h % STATS_SHARDS];
+    int start = (int)((h / STATS_SHARDS) % STATS_SEGMENT_SLOTS);
+
+    for (StatsSegment* seg = segmentAt(link, create); seg; seg = segmentAt(link, create)) {
+        for (int k = 0; k < STATS_PROBE_LIMIT; k++) {
+            PlayerStats* slot = &seg->slots[(start + k) % STATS_SEGMENT_SLOTS];
+            uint64_t id = slot->player_id.load(std::memory_order_acquire);
+            if (id == player_id) return slot;
+            if (id == 0) {
+                if (!create) return nullptr;   // 记录只增不删，遇到空槽说明不存在
+                if (slot->player_id.compare_exchange_strong(id, player_id, std::memory_order_acq_rel)) {
+                    store->player_count.fetch_add(1, std::memory_order_relaxed);
+                    return slot;
+                }
+                if (id == player_id) return slot;  // 别的线程刚插入了同一个玩家
+            }
+        }
+        link = &seg->next;
+    }
+    return nullptr;
+}
+
+void playerStatsRecord(PlayerStatsStore* store, uint64_t player_id, int won, int attempts) {
+    PlayerStats* p = playerStatsFind(store, player_id, 1);
+    p->games_played.fetch_add(1, std::memory_order_relaxed);
+    if (won) {
+        p->games_won.fetch_add(1, std::memory_order_relaxed);
+        int streak = p->current_streak.fetch_add(1, std::memory_order_relaxed) + 1;
+        int best = p->max_streak.load(std::memory_order_relaxed);
+        while (streak > best && !p->max_streak.compare_exchange_weak(best, streak, std::memory_order_relaxed)) {
+        }
+        if (attempts >= 1 && attempts <= MAX_ATTEMPTS) {
+            p->guess_distribution[attempts - 1].fetch_add(1, std::memory_order_relaxed);
+        }
+    } else {
+        p->current_streak.store(0, std::memory_order_relaxed);
+    }
+    store->version.fetch_add(1, std::memory_order_release);
+}
+
+static void readStats(const PlayerStats* p, Statistics* out) {
+    out->games_played = p->games_played.load(std::memory_order_relaxed);
+    out->games_won = p->games_won.load(std::memory_order_relaxed);
+    out->current_streak = p->current_streak.load(std::memory_order_relaxed);
+    out->max_streak = p->max_streak.load(std::memory_order_relaxed);
+    for (int i = 0; i < MAX_ATTEMPTS; i++) {
+        out->guess_distribution[i] = p->guess_distribution[i].load(std::memory_order_relaxed);
+    }
+}
+
+void playerStatsSnapshot(PlayerStatsStore* store, uint64_t player_id, Statistics* out) {
+    PlayerStats* p = playerStatsFind(store, player_id, 0);
+    if (p) {
+        readStats(p, out);
+    } else {
+        memset(out, 0, sizeof(Statistics));
+    }
+}
+
+void playerStatsImport(PlayerStatsStore* store, uint64_t player_id, const Statistics* in) {
+    PlayerStats* p = playerStatsFind(store, player_id, 1);
+    p->games_played.store(in->games_played, std::memory_order_relaxed);
+    p->games_won.store(in->games_won, std::memory_order_relaxed);
+    p->current_streak.store(in->current_streak, std::memory_order_relaxed);
+    p->max_streak.store(in->max_streak, std::memory_order_relaxed);
+    for (int i = 0; i < MAX_ATTEMPTS; i++) {
+        p->guess_distribution[i].store(in->guess_distribution[i], std::memory_order_relaxed);
+    }
+    store->version.fetch_add(1, std::memory_order_release);
+}
+
+static size_t slotBytes(uint32_t capacity) {
+    return (sizeof(StatsSlotHeader) + (size_t)capacity * sizeof(PlayerRecord) + 63) / 64 * 64;
+}
+
+static size_t fileBytes(uint32_t capacity) {
+    return sizeof(StatsFileHeader) + 2 * slotBytes(capacity);
+}
+
+static uint8_t* slotAt(const StatsFile* f, int slot) {
+    return f->base + sizeof(StatsFileHeader) + slot * slotBytes(f->capacity);
+}
+
+static uint32_t checksum(const StatsSlotHeader* h, const PlayerRecord* records) {
+    // FNV-1a，按 8 字节一步
+    uint64_t head[2] = { h->seq, h->count };
+    const uint64_t* words = (const uint64_t*)records;
+    size_t n = (size_t)h->count * sizeof(PlayerRecord) / sizeof(uint64_t);
+    uint64_t x = 1469598103934665603ull;
+    for (int i = 0; i < 2; i++) x = (x ^ head[i]) * 1099511628211ull;
+    for (size_t i = 0; i < n; i++) x = (x ^ words[i]) * 1099511628211ull;
+    return (uint32_t)(x ^ (x >> 32));
+}
+
+static int slotValid(const uint8_t* slot, uint32_t capacity) {
+    const StatsSlotHeader* h = (const StatsSlotHeader*)slot;
+    return h->seq != 0 && h->count <= capacity &&
+           checksum(h, (const PlayerRecord*)(h + 1)) == h->checksum;
+}
+
+//把全部记录写进一个槽，槽头最后写；记录比 capacity 多时返回 -1（槽已写坏，另一个槽不受影响）
+static int fillSlot(PlayerStatsStore* store, uint8_t* slot, uint32_t capacity, uint64_t seq) {
+    StatsSlotHeader* h = (StatsSlotHeader*)slot;
+    PlayerRecord* records = (PlayerRecord*)(h + 1);
+    uint32_t count = 0;
+    playerStatsForEach(store, [&](PlayerStats* p) {
+        if (count == capacity) {
+            count++;
+            return false;
+        }
+        PlayerRecord r;
+        memset(&r, 0, sizeof(r));
+        r.player_id = p->player_id.load(std::memory_order_relaxed);
+        readStats(p, &r.stats);
+        memcpy(&records[count++], &r, sizeof(r));
+        return true;
+    });
+    if (count > capacity) return -1;
+    StatsSlotHeader done = { seq, count, 0 };
+    done.checksum = checksum(&done, records);
+    memcpy(h, &done, sizeof(done));
+    return (int)count;
+}
+
+static int fileRename(const char* from, const char* to) {
+    if (rename(from, to) == 0) return 1;
+    remove(to);     // Windows 下 rename 不能覆盖已有文件
+    return rename(from, to) == 0;
+}
+
+//新建整个文件：槽 0 为当前全部记录，先写临时文件、刷到磁盘再改名，改名前旧文件一直完好
+static int writeFresh(PlayerStatsStore* store, const char* path, uint32_t capacity, uint64_t seq) {
+    std::vector<uint8_t> image(fileBytes(capacity), 0);
+    StatsFileHeader* h = (StatsFileHeader*)image.data();
+    memcpy(h->magic, STATS_FILE_MAGIC, sizeof(h->magic));
+    h->version = STATS_FILE_VERSION;
+    h->record_size = sizeof(PlayerRecord);
+    h->capacity = capacity;
+    if (fillSlot(store, image.data() + sizeof(StatsFileHeader), capacity, seq) < 0) return 0;
+
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) return 0;
+    int ok = fwrite(image.data(), image.size(), 1, fp) == 1 && fflush(fp) == 0;
+#if defined(_WIN32)
+    ok = ok && _commit(_fileno(fp)) == 0;
+#else
+    ok = ok && fsync(fileno(fp)) == 0;
+#endif
+    ok = fclose(fp) == 0 && ok;
+    if (!ok) {
+        remove(tmp);
+        return 0;
+    }
+    return fileRename(tmp, path);
+}
+
+//映射好之后检查文件头，找出最新的有效槽
+static int attach(StatsFile* f, uint8_t* base, size_t bytes) {
+    const StatsFileHeader* h = (const StatsFileHeader*)base;
+    if (bytes < sizeof(StatsFileHeader) || memcmp(h->magic, STATS_FILE_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != STATS_FILE_VERSION || h->record_size != sizeof(PlayerRecord) || h->capacity == 0 ||
+        fileBytes(h->capacity) > bytes) {
+        return 0;
+    }
+    f->base = base;
+    f->bytes = bytes;
+    f->capacity = h->capacity;
+    f->slot = -1;
+    f->seq = 0;
+    for (int i = 0; i < 2; i++) {
+        const StatsSlotHeader* s = (const StatsSlotHeader*)slotAt(f, i);
+        if (slotValid((const uint8_t*)s, f->capacity) && s->seq > f->seq) {
+            f->slot = i;
+            f->seq = s->seq;
+        }
+    }
+    return 1;
+}
+
+//打不开或映射失败（权限、被别的程序占用）与打开了但内容不对要分开：前者不能当成损坏处理
+enum { MAP_INVALID = -1, MAP_ERROR = 0, MAP_OK = 1, MAP_MISSING = 2 };
+
+#if defined(_WIN32)
+
+static int mapFile(StatsFile* f, int writable) {
+    HANDLE file = CreateFileA(f->path, writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        DWORD e = GetLastError();
+        return e == ERROR_FILE_NOT_FOUND || e == ERROR_PATH_NOT_FOUND ? MAP_MISSING : MAP_ERROR;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return MAP_ERROR;
+    }
+    if (size.QuadPart < (LONGLONG)sizeof(StatsFileHeader)) {
+        CloseHandle(file);
+        return MAP_INVALID;
+    }
+    HANDLE m = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+    void* base = m ? MapViewOfFile(m, writable ? FILE_MAP_ALL_ACCESS : FILE_MAP_READ, 0, 0, 0) : nullptr;
+    int r = !base ? MAP_ERROR : attach(f, (uint8_t*)base, (size_t)size.QuadPart) ? MAP_OK : MAP_INVALID;
+    if (r != MAP_OK) {
+        if (base) UnmapViewOfFile(base);
+        if (m) CloseHandle(m);
+        CloseHandle(file);
+        f->base = nullptr;
+        return r;
+    }
+    f->handle = file;
+    f->mapping = m;
+    return MAP_OK;
+}
+
+static void unmapFile(StatsFile* f) {
+    if (!f->base) return;
+    UnmapViewOfFile(f->base);
+    CloseHandle((HANDLE)f->mapping);
+    CloseHandle((HANDLE)f->handle);
+    f->base = nullptr;
+}
+
+static int flushRange(StatsFile* f, const uint8_t* p, size_t len) {
+    return FlushViewOfFile(p, len) && FlushFileBuffers((HANDLE)f->handle);
+}
+
+#else
+
+static int mapFile(StatsFile* f, int writable) {
+    int fd = open(f->path, writable ? O_RDWR : O_RDONLY);
+    if (fd < 0) return errno == ENOENT ? MAP_MISSING : MAP_ERROR;
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return MAP_ERROR;
+    }
+    if (st.st_size < (off_t)sizeof(StatsFileHeader)) {
+        close(fd);
+        return MAP_INVALID;
+    }
+    void* base = mmap(nullptr, (size_t)st.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return MAP_ERROR;
+    if (!attach(f, (uint8_t*)base, (size_t)st.st_size)) {
+        munmap(base, (size_t)st.st_size);
+        f->base = nullptr;
+        return MAP_INVALID;
+    }
+    return MAP_OK;
+}
+
+static void unmapFile(StatsFile* f) {
+    if (!f->base) return;
+    munmap(f->base, f->bytes);
+    f->base = nullptr;
+}
+
+//msync 的起点要按页对齐
+static int flushRange(StatsFile*, const uint8_t* p, size_t len) {
+    uintptr_t page = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t start = (uintptr_t)p / page * page;
+    return msync((void*)start, (uintptr_t)p + len - start, MS_SYNC) == 0;
+}
+
+#endif
+
+//版本 1 的存档：记录数 + 顺序写入的记录
+static int loadLegacy(PlayerStatsStore* store, FILE* fp) {
+    int32_t header[3];
+    int ok = fread(header, sizeof(header), 1, fp) == 1 &&
+             memcmp(header, LEGACY_MAGIC, sizeof(LEGACY_MAGIC)) == 0 &&
+             header[1] == LEGACY_VERSION && header[2] >= 0;
+    for (int i = 0; ok && i < header[2]; i++) {
+        PlayerRecord r;
+        ok = fread(&r, sizeof(r), 1, fp) == 1 && r.player_id != 0;
+        if (ok) playerStatsImport(store, r.player_id, &r.stats);
+    }
+    return ok;
+}
+
+//新建文件并映射，capacity 至少是当前玩家数的两倍
+static int createFile(PlayerStatsStore* store, uint64_t seq) {
+    StatsFile* f = &store->file;
+    uint32_t capacity = STATS_FILE_CAPACITY;
+    while (capacity < 2 * (uint32_t)store->player_count.load(std::memory_order_relaxed)) capacity *= 2;
+    unmapFile(f);
+    if (!writeFresh(store, f->path, capacity, seq)) {
+        mapFile(f, 1);  // 旧文件还在，接着用
+        return 0;
+    }
+    return mapFile(f, 1) == MAP_OK;
+}
+
+//读入映射里最新有效槽的全部记录
+static void importSlot(PlayerStatsStore* store) {
+    StatsFile* f = &store->file;
+    const StatsSlotHeader* h = (const StatsSlotHeader*)slotAt(f, f->slot);
+    const PlayerRecord* records = (const PlayerRecord*)(h + 1);
+    for (uint32_t i = 0; i < h->count; i++) {
+        if (records[i].player_id != 0) playerStatsImport(store, records[i].player_id, &records[i].stats);
+    }
+}
+
+int playerStatsLoad(PlayerStatsStore* store, const char* path) {
+    StatsFile* f = &store->file;
+    snprintf(f->path, sizeof(f->path), "%s", path);
+    int status = PLAYERS_LOADED;
+    int r = mapFile(f, 1);
+    if (r == MAP_MISSING) {
+        if (!createFile(store, 1)) return PLAYERS_UNAVAILABLE;
+        store->saved_version = store->version.load(std::memory_order_acquire);
+        return PLAYERS_NEW;
+    }
+    if (r == MAP_ERROR) {
+        // 文件在但不能写（只读、被占用）：尽量读出来，本次运行不保存，文件原样不动
+        if (mapFile(f, 0) != MAP_OK) return PLAYERS_UNAVAILABLE;
+        if (f->slot >= 0) importSlot(store);
+        unmapFile(f);
+        return f->slot >= 0 ? PLAYERS_LOADED : PLAYERS_UNAVAILABLE;
+    }
+    if (r == MAP_OK && f->slot >= 0) {
+        importSlot(store);
+        store->saved_version = store->version.load(std::memory_order_acquire);
+        return PLAYERS_LOADED;
+    }
+    if (r == MAP_OK) {
+        unmapFile(f);   // 文件头完好但两个槽都坏了
+        status = PLAYERS_RECOVERED;
+    } else {
+        FILE* fp = fopen(path, "rb");
+        int legacy = fp && loadLegacy(store, fp);
+        if (fp) fclose(fp);
+        if (!legacy) status = PLAYERS_RECOVERED;
+    }
+    if (status == PLAYERS_RECOVERED) {
+        // 确实校验不过才改名留给人查看，不直接覆盖
+        char bad[512];
+        snprintf(bad, sizeof(bad), "%s.bad", path);
+        if (!fileRename(path, bad)) return PLAYERS_UNAVAILABLE;
+    }
+    if (!createFile(store, 1)) return PLAYERS_UNAVAILABLE;
+    store->saved_version = store->version.load(std::memory_order_acquire);
+    return status;
+}
+
+int playerStatsSave(PlayerStatsStore* store) {
+    StatsFile* f = &store->file;
+    if (!f->base) return 0;
+    uint64_t v = store->version.load(std::memory_order_acquire);
+    if (v == store->saved_version) return 1;
+    int next = f->slot == 0 ? 1 : 0;
+    uint8_t* slot = slotAt(f, next);
+    int ok;
+    if (fillSlot(store, slot, f->capacity, f->seq + 1) >= 0) {
+        ok = flushRange(f, slot, slotBytes(f->capacity));
+        if (ok) {
+            f->slot = next;
+            f->seq++;
+        }
+    } else {
+        // 槽放不下了：换一个更大的文件
+        ok = createFile(store, f->seq + 1);
+    }
+    if (ok) store->saved_version = v;
+    return ok;
+}
+
+void playerStatsStartAutosave(PlayerStatsStore* store, int interval_ms) {
+    if (store->autosave_running.exchange(true)) return;
+    store->autosave_thread = std::thread([store, interval_ms]() {
+        int waited = 0;
+        while (store->autosave_running.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            waited += 50;
+            if (waited < interval_ms) continue;
+            waited = 0;
+            playerStatsSave(store);
+        }
+        playerStatsSave(store);
+    });
+}
+
+void playerStatsStopAutosave(PlayerStatsStore* store) {
+    if (!store->autosave_running.exchange(false)) return;
+    if (store->autosave_thread.joinable()) store->autosave_thread.join();
+}
+
+uint64_t playerIdFromName(const char* name) {
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (const char* p = name; *p; p++) {
+        h = (h ^ (uint8_t)*p) * 0x100000001B3ull;
+    }
+    return h ? h : 1;
+}
@@ -0,0 +1,113 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+#include <thread>
+#include "scoring.h"
+
+//统计数据结构
+struct Statistics {
+    int games_played;
+    int games_won;
+    int current_streak;
+    int max_streak;
+    int guess_distribution[MAX_ATTEMPTS];
+};
+
+//每个玩家一条记录，字段都是原子量，更新时不加锁
+struct PlayerStats {
+    std::atomic<uint64_t> player_id;   // 0 表示空槽
+    std::atomic<int> games_played;
+    std::atomic<int> games_won;
+    std::atomic<int> current_streak;
+    std::atomic<int> max_streak;
+    std::atomic<int> guess_distribution[MAX_ATTEMPTS];
+};
+
+const int STATS_SHARDS = 64;
+const int STATS_SEGMENT_SLOTS = 256;
+const int STATS_PROBE_LIMIT = 32;   // 段内线性探测的最大步数，探测不到就去下一段
+
+//分片哈希表：按玩家 id 分到 STATS_SHARDS 个分片，每个分片是一串定长段。
+//记录一旦插入就不再移动，查找、插入（CAS 抢空槽）和追加新段（CAS 接到链尾）都不加锁
+struct StatsSegment {
+    PlayerStats slots[STATS_SEGMENT_SLOTS];
+    std::atomic<StatsSegment*> next;
+};
+
+//存档文件：文件头之后是两个同样大小的槽，每个槽是槽头（序号、记录数、校验和）加 capacity 条记录。
+//保存时把全部记录直接写进映射里较旧的那个槽，最后写槽头并刷盘；读取时取校验通过、序号最大的槽。
+//写到一半崩溃只会坏掉正在写的槽，另一个槽还是上一次完整的存档
+const int STATS_FILE_VERSION = 2;
+const uint32_t STATS_FILE_CAPACITY = 256;  // 新文件每个槽的记录数，玩家更多时换一个两倍大的文件
+
+struct StatsFile {
+    char path[260];
+    uint8_t* base;                      // 映射起点，为空表示没有打开
+    size_t bytes;
+    uint32_t capacity;
+    int slot;                           // 最新的有效槽，-1 表示两个都无效
+    uint64_t seq;                       // 最新有效槽的序号
+    void* handle;                       // Windows 下的文件句柄与映射句柄
+    void* mapping;
+};
+
+struct PlayerStatsStore {
+    std::atomic<StatsSegment*> shards[STATS_SHARDS];
+    std::atomic<int> player_count;
+    std::atomic<uint64_t> version;     // 每次记录对局加一，自动保存据此判断是否需要写盘
+    uint64_t saved_version;            // 存档里是哪个版本，只在保存的线程里读写
+    StatsFile file;
+
+    std::atomic<bool> autosave_running;
+    std::thread autosave_thread;
+};
+
+void playerStatsInit(PlayerStatsStore* store);
+void playerStatsFree(PlayerStatsStore* store);
+
+//查找玩家记录，create 为真时不存在则插入；player_id 不能为 0
+PlayerStats* playerStatsFind(PlayerStatsStore* store, uint64_t player_id, int create);
+
+//记录一局结果，attempts 为猜中所用次数（未猜中时忽略）
+void playerStatsRecord(PlayerStatsStore* store, uint64_t player_id, int won, int attempts);
+
+//读出某个玩家的统计，不存在时全部为 0
+void playerStatsSnapshot(PlayerStatsStore* store, uint64_t player_id, Statistics* out);
+//用已有数据覆盖某个玩家的记录（导入旧存档）
+void playerStatsImport(PlayerStatsStore* store, uint64_t player_id, const Statistics* in);
+
+//遍历所有玩家，fn 返回 0 时停止
+template <typename Fn>
+void playerStatsForEach(PlayerStatsStore* store, Fn fn) {
+    for (int s = 0; s < STATS_SHARDS; s++) {
+        for (StatsSegment* seg = store->shards[s].load(std::memory_order_acquire); seg;
+             seg = seg->next.load(std::memory_order_acquire)) {
+            for (int i = 0; i < STATS_SEGMENT_SLOTS; i++) {
+                if (seg->slots[i].player_id.load(std::memory_order_acquire) != 0) {
+                    if (!fn(&seg->slots[i])) return;
+                }
+            }
+        }
+    }
+}
+
+//playerStatsLoad 的结果
+enum {
+    PLAYERS_LOADED,         // 读入了存档（旧版存档读入后已转换）
+    PLAYERS_NEW,            // 文件不存在，已新建
+    PLAYERS_RECOVERED,      // 文件校验不过，已改名为 .bad 并新建，从空记录开始
+    PLAYERS_UNAVAILABLE,    // 文件打不开或写不了，本次运行不保存（只读时已尽量读入）
+};
+
+//打开（映射）存档文件并读入最新的有效槽，之后的保存都写这个文件。
+//文件头或两个槽都校验不过时才把原文件改名为 .bad 留着再新建；打开或映射出错时不动文件。返回 PLAYERS_*
+int playerStatsLoad(PlayerStatsStore* store, const char* path);
+//有新对局时把全部记录写进存档文件较旧的槽，没有打开文件时返回 0
+int playerStatsSave(PlayerStatsStore* store);
+
+//后台线程每隔 interval_ms 保存一次
+void playerStatsStartAutosave(PlayerStatsStore* store, int interval_ms);
+void playerStatsStopAutosave(PlayerStatsStore* store);
+
+//由玩家名得到 id（FNV-1a，保证非 0）
+uint64_t playerIdFromName(const char* name);
@@ -0,0 +1,104 @@
+#include "sampling.h"
+
+void aliasBuild(AliasTable* t, const float* weights, int n) {
+    t->n = n;
+    t->threshold.clear();
+    t->alias.clear();
+    if (!weights || n <= 0) return;
+    double total = 0;
+    for (int i = 0; i < n; i++) total += weights[i];
+    if (total <= 0) return;
+
+    // Vose：按 n * p_i 与 1 比较分成小、大两组，每个小格子用一个大格子补满
+    std::vector<double> scaled(n);
+    std::vector<uint32_t> small, large;
+    small.reserve(n);
+    large.reserve(n);
+    for (int i = 0; i < n; i++) {
+        scaled[i] = weights[i] * (double)n / total;
+        if (scaled[i] < 1.0) small.push_back((uint32_t)i);
+        else large.push_back((uint32_t)i);
+    }
+    t->threshold.assign(n, 0xFFFFFFFFu);
+    t->alias.resize(n);
+    for (int i = 0; i < n; i++) t->alias[i] = (uint32_t)i;
+    while (!small.empty() && !large.empty()) {
+        uint32_t s = small.back();
+        small.pop_back();
+        uint32_t l = large.back();
+        t->threshold[s] = (uint32_t)(scaled[s] * 4294967296.0);
+        t->alias[s] = l;
+        scaled[l] -= 1.0 - scaled[s];
+        if (scaled[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    // 剩下的只差舍入误差，留给自己（threshold 保持全满，alias 指向自己）
+}
+
+uint64_t sampleRandom(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static double weightOf(const float* weights, uint32_t i) {
+    return weights ? weights[i] : 1.0;
+}
+
+//在本轮还没抽到的下标上重建别名表
+static void rebuild(SessionSampler* s, const float* weights) {
+    size_t kept = 0;
+    for (size_t k = 0; k < s->ids.size(); k++) {
+        uint32_t id = s->ids[k];
+        if (!(s->used[id >> 6] & (1ull << (id & 63)))) s->ids[kept++] = id;
+    }
+    s->ids.resize(kept);
+    s->scratch.resize(kept);
+    s->table_weight = 0;
+    for (size_t k = 0; k < kept; k++) {
+        s->scratch[k] = (float)weightOf(weights, s->ids[k]);
+        s->table_weight += s->scratch[k];
+    }
+    s->used_weight = 0;
+    aliasBuild(&s->table, weights ? s->scratch.data() : nullptr, (int)kept);
+}
+
+//开始新的一轮：所有权重 > 0 的下标；全部为 0 时按等概率处理
+static void newRound(SessionSampler* s, const float* weights) {
+    s->used.assign(((size_t)s->n + 63) / 64, 0);
+    s->ids.clear();
+    for (int i = 0; i < s->n; i++) {
+        if (weightOf(weights, (uint32_t)i) > 0) s->ids.push_back((uint32_t)i);
+    }
+    if (s->ids.empty()) {
+        for (int i = 0; i < s->n; i++) s->ids.push_back((uint32_t)i);
+        weights = nullptr;
+    }
+    s->remaining = (int)s->ids.size();
+    rebuild(s, weights);
+}
+
+void samplerReset(SessionSampler* s, const float* weights, int n, uint64_t key) {
+    s->key = key;
+    s->n = n;
+    newRound(s, weights);
+}
+
+uint32_t samplerNext(SessionSampler* s, const float* weights, uint64_t* rng) {
+    if (s->remaining == 0) newRound(s, weights);
+    // 权重全为 0 时 newRound 按等概率建表，这里也要一致
+    if (s->table.threshold.empty()) weights = nullptr;
+    for (;;) {
+        if (s->used_weight * 2 > s->table_weight) rebuild(s, weights);
+        uint32_t id = s->ids[aliasSample(&s->table, sampleRandom(rng))];
+        uint64_t bit = 1ull << (id & 63);
+        if (s->used[id >> 6] & bit) continue;
+        s->used[id >> 6] |= bit;
+        s->used_weight += weightOf(weights, id);
+        s->remaining--;
+        return id;
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+//按权重抽样（Walker/Vose 别名法）：建表 O(n)，每次抽样 O(1)，只用一个 64 位随机数。
+//weights 为空表示等概率；权重为 0 的项永远不会被抽到，全为 0 时退化为等概率
+struct AliasTable {
+    int n;
+    std::vector<uint32_t> threshold;   // 第 i 格留给自己的概率 * 2^32
+    std::vector<uint32_t> alias;       // 没留给自己时改抽的下标
+};
+
+void aliasBuild(AliasTable* t, const float* weights, int n);
+//r 为均匀的 64 位随机数：高 32 位选格子，低 32 位决定取自己还是 alias
+inline uint32_t aliasSample(const AliasTable* t, uint64_t r) {
+    uint32_t i = (uint32_t)(((r >> 32) * (uint64_t)t->n) >> 32);
+    if (t->threshold.empty()) return i;   // 等概率
+    return (uint32_t)r < t->threshold[i] ? i : t->alias[i];
+}
+
+//splitmix64，抽样用的随机数
+uint64_t sampleRandom(uint64_t* state);
+
+//不放回抽样：一轮内每个下标（权重 > 0 的）只抽一次，抽完自动开始下一轮。
+//抽到已用过的就重抽；已用权重超过表内总权重一半时，在剩下的下标上重建别名表，
+//所以每次期望不超过 2 次抽样，重建的开销均摊下来是常数
+struct SessionSampler {
+    uint64_t key;                   // 使用者记录表是按哪份数据建的（例如词库 hash）
+    int n;
+    std::vector<uint32_t> ids;      // 当前别名表覆盖的下标
+    AliasTable table;               // ids 上的别名表
+    std::vector<uint64_t> used;     // 本轮已抽过的下标（位图）
+    double table_weight;            // 别名表覆盖的总权重
+    double used_weight;             // 其中已经抽走的
+    int remaining;                  // 本轮还没抽到的个数
+    std::vector<float> scratch;
+};
+
+//weights 可为空（等概率），必须在 samplerNext 时原样传入
+void samplerReset(SessionSampler* s, const float* weights, int n, uint64_t key);
+uint32_t samplerNext(SessionSampler* s, const float* weights, uint64_t* rng);
@@ -0,0 +1,165 @@
+#include "scene.h"
+#include <algorithm>
+
+static int clampInt(int v, int lo, int hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+static int rectsTouch(const SceneRect& a, const SceneRect& b) {
+    // 相邻（相差一个像素）也算，连在一起的格子合成一块
+    return a.x0 <= b.x1 + 1 && b.x0 <= a.x1 + 1 && a.y0 <= b.y1 + 1 && b.y0 <= a.y1 + 1;
+}
+
+static int rectsIntersect(const SceneRect& a, const SceneRect& b) {
+    return a.x0 <= b.x1 && b.x0 <= a.x1 && a.y0 <= b.y1 && b.y0 <= a.y1;
+}
+
+static SceneRect rectUnion(const SceneRect& a, const SceneRect& b) {
+    return { std::min(a.x0, b.x0), std::min(a.y0, b.y0), std::max(a.x1, b.x1), std::max(a.y1, b.y1) };
+}
+
+void sceneInit(Scene* s, int width, int height) {
+    s->width = width;
+    s->height = height;
+    s->grid_cols = (width + SCENE_GRID - 1) / SCENE_GRID;
+    s->grid_rows = (height + SCENE_GRID - 1) / SCENE_GRID;
+    s->grid.assign((size_t)s->grid_cols * s->grid_rows, std::vector<int>());
+    s->stamp_now = 0;
+    sceneClear(s);
+}
+
+void sceneClear(Scene* s) {
+    s->widgets.clear();
+    s->stamp.clear();
+    for (auto& cell : s->grid) cell.clear();
+    s->dirty.clear();
+    sceneInvalidateRect(s, { 0, 0, s->width - 1, s->height - 1 });
+}
+
+int sceneAdd(Scene* s, int kind, int id, int x, int y, int w, int h, int clickable) {
+    int index = (int)s->widgets.size();
+    Widget wd;
+    wd.rect = { x, y, x + w, y + h };
+    wd.kind = kind;
+    wd.id = id;
+    wd.clickable = clickable;
+    wd.visible = 1;
+    wd.look = 0;
+    s->widgets.push_back(wd);
+    s->stamp.push_back(0);
+
+    // 登记到相交的每个格子，下标递增加入，格子里的列表天然有序
+    int gx0 = clampInt(wd.rect.x0 / SCENE_GRID, 0, s->grid_cols - 1);
+    int gx1 = clampInt(wd.rect.x1 / SCENE_GRID, 0, s->grid_cols - 1);
+    int gy0 = clampInt(wd.rect.y0 / SCENE_GRID, 0, s->grid_rows - 1);
+    int gy1 = clampInt(wd.rect.y1 / SCENE_GRID, 0, s->grid_rows - 1);
+    for (int gy = gy0; gy <= gy1; gy++) {
+        for (int gx = gx0; gx <= gx1; gx++) {
+            s->grid[(size_t)gy * s->grid_cols + gx].push_back(index);
+        }
+    }
+    sceneInvalidate(s, index);
+    return index;
+}
+
+int sceneSetLook(Scene* s, int widget, uint64_t look) {
+    Widget* wd = &s->widgets[widget];
+    if (wd->look == look) return 0;
+    wd->look = look;
+    if (wd->visible) sceneInvalidate(s, widget);
+    return 1;
+}
+
+int sceneSetVisible(Scene* s, int widget, int visible) {
+    Widget* wd = &s->widgets[widget];
+    visible = visible ? 1 : 0;
+    if (wd->visible == visible) return 0;
+    wd->visible = visible;
+    sceneInvalidate(s, widget);   // 隐藏时露出下层，同样需要重画
+    return 1;
+}
+
+void sceneInvalidate(Scene* s, int widget) {
+    sceneInvalidateRect(s, s->widgets[widget].rect);
+}
+
+void sceneInvalidateRect(Scene* s, SceneRect r) {
+    s->dirty.push_back(r);
+}
+
+int sceneHitTest(Scene* s, int x, int y) {
+    if (x < 0 || y < 0 || x >= s->width || y >= s->height) return -1;
+    const std::vector<int>& cell = s->grid[(size_t)(y / SCENE_GRID) * s->grid_cols + x / SCENE_GRID];
+    for (int i = (int)cell.size() - 1; i >= 0; i--) {
+        const Widget* wd = &s->widgets[cell[i]];
+        if (!wd->visible || !wd->clickable) continue;
+        if (x >= wd->rect.x0 && x <= wd->rect.x1 && y >= wd->rect.y0 && y <= wd->rect.y1) return cell[i];
+    }
+    return -1;
+}
+
+void sceneQuery(Scene* s, SceneRect r, std::vector<int>& out) {
+    out.clear();
+    if (++s->stamp_now == 0) {
+        std::fill(s->stamp.begin(), s->stamp.end(), 0);
+        s->stamp_now = 1;
+    }
+    int gx0 = clampInt(r.x0 / SCENE_GRID, 0, s->grid_cols - 1);
+    int gx1 = clampInt(r.x1 / SCENE_GRID, 0, s->grid_cols - 1);
+    int gy0 = clampInt(r.y0 / SCENE_GRID, 0, s->grid_rows - 1);
+    int gy1 = clampInt(r.y1 / SCENE_GRID, 0, s->grid_rows - 1);
+    for (int gy = gy0; gy <= gy1; gy++) {
+        for (int gx = gx0; gx <= gx1; gx++) {
+            for (int index : s->grid[(size_t)gy * s->grid_cols + gx]) {
+                if (s->stamp[index] == s->stamp_now) continue;
+                s->stamp[index] = s->stamp_now;
+                const Widget* wd = &s->widgets[index];
+                if (wd->visible && rectsIntersect(wd->rect, r)) out.push_back(index);
+            }
+        }
+    }
+    std::sort(out.begin(), out.end());
+}
+
+void sceneTakeDirty(Scene* s, std::vector<SceneRect>& out) {
+    out.clear();
+    for (SceneRect r : s->dirty) {
+        r.x0 = std::max(r.x0, 0);
+        r.y0 = std::max(r.y0, 0);
+        r.x1 = std::min(r.x1, s->width - 1);
+        r.y1 = std::min(r.y1, s->height - 1);
+        if (r.x0 > r.x1 || r.y0 > r.y1) continue;
+
+        // 与已有的脏区相接就合并，合并后的矩形可能又与别的相接，反复直到不再变化
+        int merged = 1;
+        while (merged) {
+            merged = 0;
+            for (size_t i = 0; i < out.size(); i++) {
+                if (rectsTouch(out[i], r)) {
+                    r = rectUnion(out[i], r);
+                    out[i] = out.back();
+                    out.pop_back();
+                    merged = 1;
+                    break;
+                }
+            }
+        }
+        out.push_back(r);
+    }
+    s->dirty.clear();
+
+    if ((int)out.size() > SCENE_MAX_DIRTY) {
+        SceneRect all = out[0];
+        for (const SceneRect& r : out) all = rectUnion(all, r);
+        out.assign(1, all);
+    }
+}
+
+uint64_t sceneHash(uint64_t h, const void* data, size_t len) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+//保留模式的界面场景：控件只记录位置、种类和“外观值”，绘制由使用者按种类完成。
+//外观值变化或显隐切换时把控件所在矩形记为脏区，每帧只重画脏区，
+//点击检测通过均匀网格只检查点击位置所在格子里的控件
+
+//控件种类
+enum {
+    WIDGET_PANEL,   // 背景、装饰等静态内容
+    WIDGET_LABEL,   // 文字
+    WIDGET_CELL,    // 盘面格子
+    WIDGET_KEY,     // 屏幕键盘按键
+    WIDGET_BUTTON,  // 按钮
+};
+
+const int SCENE_GRID = 40;          // 网格边长（像素）
+const int SCENE_MAX_DIRTY = 24;     // 脏区超过这么多个时合并成一个外接矩形
+
+//矩形，包含 [x0, x1] x [y0, y1] 两端
+struct SceneRect {
+    int x0, y0, x1, y1;
+};
+
+struct Widget {
+    SceneRect rect;
+    int kind;
+    int id;          // 由使用者解释，例如按键的字母编号、按钮编号
+    int clickable;
+    int visible;
+    uint64_t look;   // 外观值：决定外观的状态打包或哈希，变化时重画
+};
+
+struct Scene {
+    int width, height;
+    int grid_cols, grid_rows;
+    std::vector<Widget> widgets;              // 按加入顺序绘制，后加入的在上层
+    std::vector<std::vector<int>> grid;       // 每个格子里与之相交的控件下标（升序）
+    std::vector<SceneRect> dirty;
+    std::vector<uint32_t> stamp;              // 查询去重用
+    uint32_t stamp_now;
+};
+
+void sceneInit(Scene* s, int width, int height);
+//清空所有控件（换页面或重新布局时），整个画面记为脏区
+void sceneClear(Scene* s);
+//加入控件，返回下标；矩形为左上角与宽高，与 EasyX 的 rectangle(x, y, x + w, y + h) 一致
+int sceneAdd(Scene* s, int kind, int id, int x, int y, int w, int h, int clickable);
+
+//更新外观值，与原来不同时记为脏区，返回是否变化
+int sceneSetLook(Scene* s, int widget, uint64_t look);
+int sceneSetVisible(Scene* s, int widget, int visible);
+void sceneInvalidate(Scene* s, int widget);
+void sceneInvalidateRect(Scene* s, SceneRect r);
+
+//点击位置上最上层的可见、可点击控件，没有返回 -1
+int sceneHitTest(Scene* s, int x, int y);
+//与矩形相交的可见控件，按绘制顺序写入 out
+void sceneQuery(Scene* s, SceneRect r, std::vector<int>& out);
+//取出本帧的脏区（已合并重叠部分并裁剪到画面内），并清空
+void sceneTakeDirty(Scene* s, std::vector<SceneRect>& out);
+
+//64 位 FNV-1a，用于把文字等内容折叠成外观值，h 从 SCENE_HASH_INIT 开始
+const uint64_t SCENE_HASH_INIT = 14695981039346656037ull;
+uint64_t sceneHash(uint64_t h, const void* data, size_t len);
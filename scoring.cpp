@@ -0,0 +1,46 @@
+#include "scoring.h"
+#include <string.h>
+
+uint8_t scorePattern(const uint8_t* guess, const uint8_t* target) {
+    uint8_t cnt[MAX_ALPHABET] = {0};
+    return scoreWithCounts(guess, target, cnt);
+}
+
+void decodePattern(uint8_t pattern, int* result) {
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        result[i] = pattern % 3 + 1;
+        pattern /= 3;
+    }
+}
+
+void scoreBatch(const Dictionary* d, const uint8_t* guess, const uint32_t* ids, int n, uint8_t* out) {
+    uint8_t cnt[MAX_ALPHABET] = {0};
+    const uint8_t* letters = d->letters.data();
+    for (int i = 0; i < n; i++) {
+        out[i] = scoreWithCounts(guess, letters + (size_t)ids[i] * WORD_LENGTH, cnt);
+    }
+}
+
+void countPatterns(const uint8_t* patterns, int n, int* counts) {
+    memset(counts, 0, sizeof(int) * PATTERN_COUNT);
+    for (int i = 0; i < n; i++) counts[patterns[i]]++;
+}
+
+void partitionByPattern(const Dictionary* d, const uint8_t* guess, const uint32_t* ids, int n,
+                        uint8_t* patterns, uint32_t* out_ids, int* bucket_start) {
+    int counts[PATTERN_COUNT];
+    scoreBatch(d, guess, ids, n, patterns);
+    countPatterns(patterns, n, counts);
+
+    int pos[PATTERN_COUNT];
+    int sum = 0;
+    for (int p = 0; p < PATTERN_COUNT; p++) {
+        bucket_start[p] = sum;
+        pos[p] = sum;
+        sum += counts[p];
+    }
+    bucket_start[PATTERN_COUNT] = sum;
+    for (int i = 0; i < n; i++) {
+        out_ids[pos[patterns[i]]++] = ids[i];
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "dictionary.h"
+
+const int MAX_ATTEMPTS = 6;
+const int MAX_BOARDS = 16;
+const int MAX_GUESSES = MAX_BOARDS + MAX_ATTEMPTS - 1; // 多词模式：N 个词有 N + 5 次机会
+
+// 反馈模式：每位 0=灰 1=黄 2=绿，第 i 位权重 3^i，共 3^5 = 243 种
+const int PATTERN_COUNT = 243;
+const uint8_t PATTERN_ALL_GREEN = 242;
+
+const uint8_t PATTERN_POW3[WORD_LENGTH] = {1, 3, 9, 27, 81};
+
+//单次打分，规则与 checkGuess 完全一致（黄色按从左到右占用目标词中未匹配的字母）
+uint8_t scorePattern(const uint8_t* guess, const uint8_t* target);
+
+//同上，计数数组由调用方提供：cnt（长 MAX_ALPHABET）必须全为 0，返回前恢复为 0，批量调用时可反复使用
+inline uint8_t scoreWithCounts(const uint8_t* guess, const uint8_t* target, uint8_t* cnt) {
+    int green = 0;
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        if (guess[i] == target[i]) {
+            green |= 1 << i;
+        } else {
+            cnt[target[i]]++;
+        }
+    }
+    int pattern = 0;
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        if (green & (1 << i)) {
+            pattern += 2 * PATTERN_POW3[i];
+        } else if (cnt[guess[i]]) {
+            cnt[guess[i]]--;
+            pattern += PATTERN_POW3[i];
+        }
+    }
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        cnt[target[i]] = 0;
+    }
+    return (uint8_t)pattern;
+}
+//展开为 checkGuess 使用的 1=灰 2=黄 3=绿
+void decodePattern(uint8_t pattern, int* result);
+
+//批量打分：一个猜测词对 n 个目标词（ids 为词库下标）
+void scoreBatch(const Dictionary* d, const uint8_t* guess, const uint32_t* ids, int n, uint8_t* out);
+
+//统计每种反馈的个数，counts 长度为 PATTERN_COUNT
+void countPatterns(const uint8_t* patterns, int n, int* counts);
+
+//按反馈对候选词做计数排序：out_ids 中同一反馈的词连续存放，
+//第 p 组为 out_ids[bucket_start[p] .. bucket_start[p + 1])，bucket_start 长度为 PATTERN_COUNT + 1。
+//patterns 为调用方提供的 n 字节缓冲区，返回时保存每个候选词的反馈
+void partitionByPattern(const Dictionary* d, const uint8_t* guess, const uint32_t* ids, int n,
+                        uint8_t* patterns, uint32_t* out_ids, int* bucket_start);
@@ -0,0 +1,182 @@
+#include "solver.h"
+#include "hardmode.h"
+#include "opening_book.h"
+#include "sampling.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+
+//熵策略最多评估的猜测词个数，超过时先按字母频率筛一遍
+const int ENTROPY_POOL_LIMIT = 300;
+
+void frequencyScores(const Dictionary* d, const uint32_t* cand, int n,
+                            const uint32_t* pool, int pool_n, int* scores) {
+    int pos[WORD_LENGTH][MAX_ALPHABET] = {{0}};
+    int presence[MAX_ALPHABET] = {0};
+    for (int i = 0; i < n; i++) {
+        const uint8_t* w = dictWord(d, cand[i]);
+        uint64_t seen = 0;
+        for (int p = 0; p < WORD_LENGTH; p++) {
+            pos[p][w[p]]++;
+            if (!(seen & (1ull << w[p]))) {
+                presence[w[p]]++;
+                seen |= 1ull << w[p];
+            }
+        }
+    }
+    for (int i = 0; i < pool_n; i++) {
+        const uint8_t* w = dictWord(d, pool[i]);
+        uint64_t seen = 0;
+        int score = 0;
+        for (int p = 0; p < WORD_LENGTH; p++) {
+            score += pos[p][w[p]];
+            if (!(seen & (1ull << w[p]))) {
+                score += presence[w[p]];
+                seen |= 1ull << w[p];
+            }
+        }
+        scores[i] = score;
+    }
+}
+
+static uint32_t pickFirst(const SolverState* s, SolverScratch*) {
+    return s->candidates[0];
+}
+
+static uint32_t pickRandom(const SolverState* s, SolverScratch* scratch) {
+    return s->candidates[sampleRandom(&scratch->rng) % s->candidate_count];
+}
+
+static uint32_t pickFrequency(const SolverState* s, SolverScratch* scratch) {
+    scratch->scores.resize(s->candidate_count);
+    frequencyScores(s->d, s->candidates, s->candidate_count, s->candidates, s->candidate_count,
+                    scratch->scores.data());
+    int best = 0;
+    for (int i = 1; i < s->candidate_count; i++) {
+        if (scratch->scores[i] > scratch->scores[best]) best = i;
+    }
+    return s->candidates[best];
+}
+
+//可以提交的猜测词：普通模式为整个词库，困难模式为满足约束的词
+static int buildGuessPool(const SolverState* s, SolverScratch* scratch) {
+    const Dictionary* d = s->d;
+    scratch->pool.resize(d->count);
+    if (!s->hard_mode) {
+        for (int i = 0; i < d->count; i++) scratch->pool[i] = (uint32_t)i;
+        return d->count;
+    }
+    HardConstraints hc;
+    hardCollect(&hc, s->guesses, s->patterns, s->attempt);
+    return hardEnumerate(d, &hc, scratch->pool.data());
+}
+
+//期望剩余候选最少（分组的 sum(c*log c) 最小，即信息熵最大）
+static uint32_t pickEntropy(const SolverState* s, SolverScratch* scratch) {
+    int n = s->candidate_count;
+    if (n <= 2) return s->candidates[0];
+
+    int pool_n = buildGuessPool(s, scratch);
+    uint32_t* pool = scratch->pool.data();
+    if (pool_n > ENTROPY_POOL_LIMIT) {
+        scratch->scores.resize(pool_n);
+        frequencyScores(s->d, s->candidates, n, pool, pool_n, scratch->scores.data());
+        std::vector<int>& sc = scratch->scores;
+        std::vector<uint32_t>& order = scratch->order;
+        order.resize(pool_n);
+        for (int i = 0; i < pool_n; i++) order[i] = (uint32_t)i;
+        std::partial_sort(order.begin(), order.begin() + ENTROPY_POOL_LIMIT, order.end(),
+                          [&](uint32_t a, uint32_t b) { return sc[a] > sc[b] || (sc[a] == sc[b] && a < b); });
+        for (int i = 0; i < ENTROPY_POOL_LIMIT; i++) order[i] = pool[order[i]];
+        memcpy(pool, order.data(), sizeof(uint32_t) * ENTROPY_POOL_LIMIT);
+        pool_n = ENTROPY_POOL_LIMIT;
+    }
+
+    scratch->patterns.resize(n);
+    int counts[PATTERN_COUNT];
+    double best_cost = 0;
+    uint32_t best = s->candidates[0];
+    int best_is_candidate = 0;
+    for (int i = 0; i < pool_n; i++) {
+        scoreBatch(s->d, dictWord(s->d, pool[i]), s->candidates, n, scratch->patterns.data());
+        countPatterns(scratch->patterns.data(), n, counts);
+        double cost = 0;
+        for (int p = 0; p < PATTERN_COUNT; p++) {
+            if (counts[p] > 1) cost += counts[p] * log((double)counts[p]);
+        }
+        // 代价相同时优先选本身可能是答案的词
+        int is_candidate = counts[PATTERN_ALL_GREEN] > 0;
+        if (i == 0 || cost < best_cost - 1e-9 ||
+            (cost < best_cost + 1e-9 && is_candidate && !best_is_candidate)) {
+            best_cost = cost;
+            best = pool[i];
+            best_is_candidate = is_candidate;
+        }
+    }
+    return best;
+}
+
+const Strategy STRATEGIES[] = {
+    { "first",   "候选词中字典序第一个",               pickFirst,     1 },
+    { "random",  "候选词中随机一个",                   pickRandom,    0 },
+    { "freq",    "候选词中字母频率得分最高的",         pickFrequency, 1 },
+    { "entropy", "按反馈分组信息熵最大的（可用非候选词）", pickEntropy,   1 },
+};
+const int STRATEGY_COUNT = sizeof(STRATEGIES) / sizeof(STRATEGIES[0]);
+
+const Strategy* findStrategy(const char* name) {
+    for (int i = 0; i < STRATEGY_COUNT; i++) {
+        if (strcmp(STRATEGIES[i].name, name) == 0) return &STRATEGIES[i];
+    }
+    return nullptr;
+}
+
+void solverInitScratch(SolverScratch* scratch, const Dictionary* d, uint64_t seed) {
+    scratch->candidates.reserve(d->count);
+    scratch->pool.reserve(d->count);
+    scratch->patterns.reserve(d->count);
+    scratch->scores.reserve(d->count);
+    scratch->order.reserve(d->count);
+    scratch->rng = seed;
+    scratch->book = nullptr;
+    scratch->opener = OPENING_NONE;
+}
+
+int solveGame(const Dictionary* d, const Strategy* st, uint32_t target, int hard_mode,
+              int max_attempts, SolverScratch* scratch, uint32_t* guesses_out) {
+    std::vector<uint32_t>& cand = scratch->candidates;
+    cand.resize(d->count);
+    for (int i = 0; i < d->count; i++) cand[i] = (uint32_t)i;
+    int n = d->count;
+
+    uint8_t rows[MAX_GUESSES * WORD_LENGTH];
+    uint8_t patterns[MAX_GUESSES];
+    uint8_t tmp[256];
+    for (int attempt = 0; attempt < max_attempts; attempt++) {
+        SolverState s = { d, hard_mode, attempt, rows, patterns, cand.data(), n };
+        uint32_t g = attempt == 0 ? scratch->opener : OPENING_NONE;
+        if (g == OPENING_NONE && scratch->book && st->pick == pickEntropy && scratch->book->hard_mode == hard_mode) {
+            g = openingLookup(scratch->book, d, attempt, rows, patterns);
+        }
+        if (g == OPENING_NONE) g = st->pick(&s, scratch);
+        const uint8_t* gw = dictWord(d, g);
+        uint8_t p = scorePattern(gw, dictWord(d, target));
+        if (guesses_out) guesses_out[attempt] = g;
+        if (p == PATTERN_ALL_GREEN) return attempt + 1;
+
+        memcpy(rows + attempt * WORD_LENGTH, gw, WORD_LENGTH);
+        patterns[attempt] = p;
+
+        // 只保留反馈一致的候选，分段打分以免额外分配
+        int kept = 0;
+        for (int base = 0; base < n; base += (int)sizeof(tmp)) {
+            int len = n - base < (int)sizeof(tmp) ? n - base : (int)sizeof(tmp);
+            scoreBatch(d, gw, cand.data() + base, len, tmp);
+            for (int i = 0; i < len; i++) {
+                if (tmp[i] == p) cand[kept++] = cand[base + i];
+            }
+        }
+        n = kept;
+    }
+    return 0;
+}
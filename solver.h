@@ -0,0 +1,54 @@
+#pragma once
+#include "dictionary.h"
+#include "scoring.h"
+
+struct OpeningBook;
+
+//自动解题：策略根据当前局面挑选下一个猜测词
+struct SolverState {
+    const Dictionary* d;
+    int hard_mode;
+    int attempt;                 // 已猜次数
+    const uint8_t* guesses;      // attempt 行，每行 WORD_LENGTH 个字母
+    const uint8_t* patterns;     // 各行反馈
+    const uint32_t* candidates;  // 与所有反馈一致的候选词
+    int candidate_count;
+};
+
+//每个线程一份的临时缓冲区，解题过程中不再分配内存
+struct SolverScratch {
+    std::vector<uint32_t> candidates;
+    std::vector<uint32_t> pool;
+    std::vector<uint8_t> patterns;
+    std::vector<int> scores;
+    std::vector<uint32_t> order;
+    uint64_t rng;
+    const OpeningBook* book;  // 可为空；熵策略的前两步先查开局库
+    uint32_t opener;          // 不为 OPENING_NONE 时第一步固定猜这个词（开局词扫描用）
+};
+
+typedef uint32_t (*StrategyFn)(const SolverState* s, SolverScratch* scratch);
+
+struct Strategy {
+    const char* name;
+    const char* description;
+    StrategyFn pick;
+    int deterministic;  // 同一目标词总是走出同样的猜测序列
+};
+
+extern const Strategy STRATEGIES[];
+extern const int STRATEGY_COUNT;
+
+const Strategy* findStrategy(const char* name);
+
+void solverInitScratch(SolverScratch* scratch, const Dictionary* d, uint64_t seed);
+
+//按候选词的字母频率给 pool 中每个词打分：位置频率 + 不重复字母的出现频率。
+//比按反馈分组便宜得多，猜测词太多时先用它筛一遍
+void frequencyScores(const Dictionary* d, const uint32_t* cand, int n,
+                     const uint32_t* pool, int pool_n, int* scores);
+
+//完整模拟一局：返回猜中所用次数，max_attempts 次内未猜中返回 0。
+//guesses_out 可为空，否则写入每次猜测的词下标
+int solveGame(const Dictionary* d, const Strategy* st, uint32_t target, int hard_mode,
+              int max_attempts, SolverScratch* scratch, uint32_t* guesses_out);
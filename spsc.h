@@ -0,0 +1,68 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+
+//单生产者单消费者的无锁环形队列：生产者只写 tail，消费者只写 head，
+//两个下标各占一个缓存行，互不干扰。容量 N 必须是 2 的幂
+template <typename T, uint32_t N>
+struct SpscQueue {
+    static_assert((N & (N - 1)) == 0, "容量必须是 2 的幂");
+    T items[N];
+    alignas(64) std::atomic<uint32_t> head{0};   // 下一个要取的位置（消费者）
+    alignas(64) std::atomic<uint32_t> tail{0};   // 下一个要放的位置（生产者）
+};
+
+//放入一项，队列满时返回 0（由调用者决定丢弃还是重试）
+template <typename T, uint32_t N>
+int spscPush(SpscQueue<T, N>* q, const T& item) {
+    uint32_t tail = q->tail.load(std::memory_order_relaxed);
+    if (tail - q->head.load(std::memory_order_acquire) == N) return 0;
+    q->items[tail & (N - 1)] = item;
+    q->tail.store(tail + 1, std::memory_order_release);
+    q->tail.notify_one();
+    return 1;
+}
+
+//取出一项，队列空时返回 0
+template <typename T, uint32_t N>
+int spscPop(SpscQueue<T, N>* q, T* out) {
+    uint32_t head = q->head.load(std::memory_order_relaxed);
+    if (head == q->tail.load(std::memory_order_acquire)) return 0;
+    *out = q->items[head & (N - 1)];
+    q->head.store(head + 1, std::memory_order_release);
+    return 1;
+}
+
+//消费者在队列为空时阻塞，直到生产者放入新的一项
+template <typename T, uint32_t N>
+void spscWait(SpscQueue<T, N>* q) {
+    uint32_t head = q->head.load(std::memory_order_relaxed);
+    q->tail.wait(head, std::memory_order_acquire);
+}
+
+//单生产者单消费者的“最新值”槽（三缓冲）：生产者随时覆盖，消费者每次拿到最近一次发布的值，双方都不等待。
+//三个格子轮换：生产者写自己的格子后与中间格子交换，消费者看到中间有新值时拿自己的格子去换
+const uint8_t LATEST_FRESH = 4;   // middle 的这一位表示中间格子里是消费者还没取走的新值
+
+template <typename T>
+struct SpscLatest {
+    T slots[3];
+    alignas(64) std::atomic<uint8_t> middle{1};   // 低 2 位为中间格子的下标
+    alignas(64) uint8_t back = 0;                 // 生产者正在写的格子
+    alignas(64) uint8_t front = 2;                // 消费者正在读的格子
+};
+
+template <typename T>
+void latestPublish(SpscLatest<T>* s, const T& value) {
+    s->slots[s->back] = value;
+    s->back = s->middle.exchange(s->back | LATEST_FRESH, std::memory_order_acq_rel) & 3;
+}
+
+//取最近一次发布的值，没有新发布时还是上次那个；返回的引用在消费者下次调用前有效
+template <typename T>
+const T& latestRead(SpscLatest<T>* s) {
+    if (s->middle.load(std::memory_order_relaxed) & LATEST_FRESH) {
+        s->front = s->middle.exchange(s->front, std::memory_order_acq_rel) & 3;
+    }
+    return s->slots[s->front];
+}
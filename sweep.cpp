@@ -0,0 +1,156 @@
+#include "sweep.h"
+#include <string.h>
+#include <algorithm>
+
+static const char SWEEP_MAGIC[8] = { 'W', 'S', 'W', 'E', 'E', 'P', '0', '1' };
+
+void sweepInit(SweepPart* p, const Dictionary* d, const char* strategy, int hard_mode,
+               int shard, int shards, const std::vector<uint32_t>& openers) {
+    SweepHeader* h = &p->h;
+    memset(h, 0, sizeof(*h));
+    memcpy(h->magic, SWEEP_MAGIC, sizeof(h->magic));
+    h->dict_hash = d->hash;
+    h->count = d->count;
+    h->hard_mode = hard_mode;
+    strncpy(h->strategy, strategy, sizeof(h->strategy) - 1);
+    h->shard = shard;
+    h->shards = shards;
+    h->opener_count = (int32_t)openers.size();
+    p->openers = openers;
+    p->results.assign((size_t)sweepShardCells(h, shard), SWEEP_PENDING);
+}
+
+int64_t sweepTotal(const SweepHeader* h) {
+    return (int64_t)std::max(h->opener_count, 1) * h->count;
+}
+
+int64_t sweepShardCells(const SweepHeader* h, int shard) {
+    int64_t total = sweepTotal(h);
+    return shard < total ? (total - shard + h->shards - 1) / h->shards : 0;
+}
+
+int sweepSameRun(const SweepPart* a, const SweepPart* b) {
+    SweepHeader x = a->h, y = b->h;
+    x.shard = y.shard = 0;
+    return memcmp(&x, &y, sizeof(x)) == 0 && a->openers == b->openers;
+}
+
+int sweepSave(const SweepPart* p, const char* path) {
+    char tmp[512];
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) return 0;
+    int ok = fwrite(&p->h, sizeof(p->h), 1, fp) == 1 &&
+             fwrite(p->openers.data(), sizeof(uint32_t), p->openers.size(), fp) == p->openers.size() &&
+             fwrite(p->results.data(), 1, p->results.size(), fp) == p->results.size();
+    ok = fclose(fp) == 0 && ok;
+    if (!ok) {
+        remove(tmp);
+        return 0;
+    }
+    if (rename(tmp, path) != 0) {
+        remove(path);   // Windows 下 rename 不能覆盖已有文件
+        if (rename(tmp, path) != 0) return 0;
+    }
+    return 1;
+}
+
+int sweepLoad(SweepPart* p, const char* path) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return 0;
+    SweepHeader* h = &p->h;
+    int ok = fread(h, sizeof(*h), 1, fp) == 1 && memcmp(h->magic, SWEEP_MAGIC, sizeof(h->magic)) == 0 &&
+             h->count > 0 && h->shards > 0 && h->shard >= 0 && h->shard < h->shards && h->opener_count >= 0;
+    if (ok) {
+        p->openers.resize(h->opener_count);
+        p->results.resize((size_t)sweepShardCells(h, h->shard));
+        ok = fread(p->openers.data(), sizeof(uint32_t), p->openers.size(), fp) == p->openers.size() &&
+             fread(p->results.data(), 1, p->results.size(), fp) == p->results.size();
+    }
+    for (size_t i = 0; ok && i < p->openers.size(); i++) ok = p->openers[i] < (uint32_t)h->count;
+    // 报告按结果字节直接下标，超出范围的文件（损坏或手改）不接受
+    for (size_t i = 0; ok && i < p->results.size(); i++) {
+        ok = p->results[i] == SWEEP_PENDING || (p->results[i] >= 0 && p->results[i] <= MAX_ATTEMPTS);
+    }
+    fclose(fp);
+    return ok;
+}
+
+static int cellScore(int8_t r) {
+    return r == SWEEP_FAILED ? MAX_ATTEMPTS + 1 : r;
+}
+
+//不固定开局：与原来 wordle_eval 的输出相同
+static void reportTargets(const SweepPart* p, const Dictionary* d, int top, FILE* out) {
+    int total = p->h.count;
+    int distribution[MAX_ATTEMPTS] = {0};
+    int failures = 0;
+    long long guess_sum = 0;
+    std::vector<uint32_t> order(total);
+    for (int i = 0; i < total; i++) {
+        int r = p->results[i];
+        order[i] = (uint32_t)i;
+        if (r == SWEEP_FAILED) {
+            failures++;
+        } else {
+            distribution[r - 1]++;
+            guess_sum += r;
+        }
+    }
+    // 最难的词：没猜出来的排最前，其次按次数从多到少
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return cellScore(p->results[a]) > cellScore(p->results[b]); });
+
+    int solved = total - failures;
+    fprintf(out, "策略: %s  模式: %s  词数: %d\n", p->h.strategy, p->h.hard_mode ? "困难" : "普通", total);
+    fprintf(out, "猜中: %d  失败: %d\n", solved, failures);
+    fprintf(out, "平均猜测次数: %.4f\n", solved > 0 ? (double)guess_sum / solved : 0.0);
+    fprintf(out, "猜测成功分布:\n");
+    for (int i = 0; i < MAX_ATTEMPTS; i++) {
+        fprintf(out, "  第%d次: %d\n", i + 1, distribution[i]);
+    }
+    fprintf(out, "  失败: %d\n", failures);
+    fprintf(out, "最难的词:\n");
+    for (int i = 0; i < total && i < top; i++) {
+        char w[WORD_TEXT_MAX];
+        alphabetDecode(&d->alphabet, dictWord(d, order[i]), w);
+        int r = p->results[order[i]];
+        if (r == SWEEP_FAILED) fprintf(out, "  %s  失败\n", w);
+        else fprintf(out, "  %s  %d\n", w, r);
+    }
+}
+
+//扫描开局词：每个开局词一行，按平均得分排名
+static void reportOpeners(const SweepPart* p, const Dictionary* d, int top, FILE* out) {
+    int rows = p->h.opener_count, count = p->h.count;
+    std::vector<double> avg(rows);
+    std::vector<int> failures(rows, 0), order(rows);
+    for (int o = 0; o < rows; o++) {
+        const int8_t* row = &p->results[(size_t)o * count];
+        long long score = 0;
+        for (int t = 0; t < count; t++) {
+            score += cellScore(row[t]);
+            failures[o] += row[t] == SWEEP_FAILED;
+        }
+        avg[o] = (double)score / count;
+        order[o] = o;
+    }
+    int shown = std::min(top, rows);
+    std::partial_sort(order.begin(), order.begin() + shown, order.end(), [&](int a, int b) {
+        return avg[a] != avg[b] ? avg[a] < avg[b] : failures[a] != failures[b] ? failures[a] < failures[b] : a < b;
+    });
+
+    fprintf(out, "策略: %s  模式: %s  开局词: %d  答案: %d\n", p->h.strategy, p->h.hard_mode ? "困难" : "普通",
+            rows, count);
+    fprintf(out, "最好的开局词（平均得分，失败记 %d）:\n", MAX_ATTEMPTS + 1);
+    for (int i = 0; i < shown; i++) {
+        char w[WORD_TEXT_MAX];
+        alphabetDecode(&d->alphabet, dictWord(d, p->openers[order[i]]), w);
+        fprintf(out, "  %2d. %-8s %.4f  失败 %d\n", i + 1, w, avg[order[i]], failures[order[i]]);
+    }
+}
+
+void sweepReport(const SweepPart* p, const Dictionary* d, int top, FILE* out) {
+    if (p->h.opener_count == 0) reportTargets(p, d, top, out);
+    else reportOpeners(p, d, top, out);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <stdio.h>
+#include <vector>
+#include "dictionary.h"
+#include "scoring.h"
+
+//策略评测的分片结果：整个评测是 (开局词, 答案) 的格子，格子 c 的开局词为第 c / count 个，答案为 c % count；
+//不固定开局时只有一行。第 i 个分片（共 N 个）负责 c % N == i 的格子，交错分配使各分片负载相近。
+//每个分片各写一个结果文件，只存自己的格子，按顺序一格一个字节；wordle_merge 把所有分片拼回整张表。
+//合并后的文件就是 1 个分片的结果文件，可以再参与合并。断点文件也是这个格式，没算完的格子为 SWEEP_PENDING
+
+const int8_t SWEEP_PENDING = -1;
+const int8_t SWEEP_FAILED = 0;
+
+struct SweepHeader {
+    char magic[8];
+    uint64_t dict_hash;
+    int32_t count;              // 词库单词数（答案数）
+    int32_t hard_mode;
+    char strategy[16];
+    int32_t shard, shards;
+    int32_t opener_count;       // 固定的开局词个数，0 表示由策略自己选；词下标紧跟在头后面
+    int32_t reserved;
+};
+
+//一个分片的结果
+struct SweepPart {
+    SweepHeader h;
+    std::vector<uint32_t> openers;
+    std::vector<int8_t> results;    // 本分片的格子，第 k 个是全表的第 shard + k * shards 个
+};
+
+void sweepInit(SweepPart* p, const Dictionary* d, const char* strategy, int hard_mode,
+               int shard, int shards, const std::vector<uint32_t>& openers);
+//整张表的格子数与某个分片的格子数
+int64_t sweepTotal(const SweepHeader* h);
+int64_t sweepShardCells(const SweepHeader* h, int shard);
+//两个分片是否属于同一次评测（除分片号外都相同）
+int sweepSameRun(const SweepPart* a, const SweepPart* b);
+
+//先写临时文件再改名，写到一半被打断也不会损坏旧文件
+int sweepSave(const SweepPart* p, const char* path);
+//文件不存在、损坏或结果字节不在 {SWEEP_PENDING, 0..MAX_ATTEMPTS} 内时返回 0
+int sweepLoad(SweepPart* p, const char* path);
+
+//整张表（1 个分片、全部算完）的报告：不固定开局时给出猜测分布与最难的词，
+//扫描开局词时按平均得分（失败记 MAX_ATTEMPTS + 1）给出前 top 个开局词
+void sweepReport(const SweepPart* p, const Dictionary* d, int top, FILE* out);
@@ -0,0 +1,189 @@
+#include "telemetry.h"
+#include <stdio.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char TELEMETRY_MAGIC[8] = { 'W', 'T', 'E', 'L', 'E', 'M', '0', '1' };
+
+static size_t ringBytes(uint32_t capacity) {
+    return sizeof(TelemetryHeader) + (size_t)capacity * sizeof(TelemetrySlot);
+}
+
+//映射好之后检查文件头，容量以文件头为准
+static int attach(TelemetryRing* r, void* base, size_t bytes) {
+    TelemetryHeader* h = (TelemetryHeader*)base;
+    if (memcmp(h->magic, TELEMETRY_MAGIC, sizeof(h->magic)) != 0 || h->slot_size != sizeof(TelemetrySlot) ||
+        h->capacity == 0 || (h->capacity & (h->capacity - 1)) != 0 || ringBytes(h->capacity) > bytes) {
+        return 0;
+    }
+    r->hdr = h;
+    r->slots = (TelemetrySlot*)(h + 1);
+    r->mask = h->capacity - 1;
+    r->bytes = bytes;
+    return 1;
+}
+
+//新建的共享内存全为 0；先写好其它字段，最后写 magic，读者看到 magic 时头已经完整
+static void format(void* base, uint32_t capacity) {
+    TelemetryHeader* h = (TelemetryHeader*)base;
+    h->capacity = capacity;
+    h->slot_size = sizeof(TelemetrySlot);
+    std::atomic_thread_fence(std::memory_order_release);
+    memcpy(h->magic, TELEMETRY_MAGIC, sizeof(h->magic));
+}
+
+#if defined(_WIN32)
+
+static void mappingName(char* out, size_t size, const char* name) {
+    snprintf(out, size, "Local\\%s", name);
+}
+
+int telemetryCreate(TelemetryRing* r, const char* name, uint32_t capacity) {
+    memset(r, 0, sizeof(*r));
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) return 0;
+    char full[256];
+    mappingName(full, sizeof(full), name);
+    size_t bytes = ringBytes(capacity);
+    HANDLE m = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                  (DWORD)((uint64_t)bytes >> 32), (DWORD)bytes, full);
+    if (!m) return 0;
+    int created = GetLastError() != ERROR_ALREADY_EXISTS;
+    void* base = MapViewOfFile(m, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (!base) {
+        CloseHandle(m);
+        return 0;
+    }
+    if (created) format(base, capacity);
+    MEMORY_BASIC_INFORMATION info;
+    size_t mapped = VirtualQuery(base, &info, sizeof(info)) ? info.RegionSize : bytes;
+    if (!attach(r, base, mapped)) {
+        UnmapViewOfFile(base);
+        CloseHandle(m);
+        return 0;
+    }
+    r->handle = m;
+    return 1;
+}
+
+int telemetryOpen(TelemetryRing* r, const char* name) {
+    memset(r, 0, sizeof(*r));
+    char full[256];
+    mappingName(full, sizeof(full), name);
+    HANDLE m = OpenFileMappingA(FILE_MAP_READ, FALSE, full);
+    if (!m) return 0;
+    void* base = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION info;
+    if (!base || !VirtualQuery(base, &info, sizeof(info)) || !attach(r, base, info.RegionSize)) {
+        if (base) UnmapViewOfFile(base);
+        CloseHandle(m);
+        return 0;
+    }
+    r->handle = m;
+    return 1;
+}
+
+void telemetryClose(TelemetryRing* r) {
+    if (r->hdr) UnmapViewOfFile(r->hdr);
+    if (r->handle) CloseHandle((HANDLE)r->handle);
+    memset(r, 0, sizeof(*r));
+}
+
+#else
+
+static void mappingName(char* out, size_t size, const char* name) {
+    snprintf(out, size, "/%s", name);
+}
+
+//读者只读映射，其它用户的观战程序也能打开
+static int mapFd(TelemetryRing* r, int fd, int writable, int format_capacity) {
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(TelemetryHeader)) return 0;
+    size_t bytes = (size_t)st.st_size;
+    void* base = mmap(nullptr, bytes, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) return 0;
+    if (format_capacity) format(base, (uint32_t)format_capacity);
+    if (!attach(r, base, bytes)) {
+        munmap(base, bytes);
+        return 0;
+    }
+    return 1;
+}
+
+int telemetryCreate(TelemetryRing* r, const char* name, uint32_t capacity) {
+    memset(r, 0, sizeof(*r));
+    if (capacity == 0 || (capacity & (capacity - 1)) != 0) return 0;
+    char full[256];
+    mappingName(full, sizeof(full), name);
+    // 只有真正新建的进程负责设置大小并写文件头，其它进程直接打开
+    int fd = shm_open(full, O_RDWR | O_CREAT | O_EXCL, 0644);
+    int created = fd >= 0;
+    if (created && ftruncate(fd, (off_t)ringBytes(capacity)) != 0) {
+        close(fd);
+        shm_unlink(full);
+        return 0;
+    }
+    if (!created) fd = shm_open(full, O_RDWR, 0);
+    if (fd < 0) return 0;
+    int ok = mapFd(r, fd, 1, created ? (int)capacity : 0);
+    close(fd);
+    return ok;
+}
+
+int telemetryOpen(TelemetryRing* r, const char* name) {
+    memset(r, 0, sizeof(*r));
+    char full[256];
+    mappingName(full, sizeof(full), name);
+    int fd = shm_open(full, O_RDONLY, 0);
+    if (fd < 0) return 0;
+    int ok = mapFd(r, fd, 0, 0);
+    close(fd);
+    return ok;
+}
+
+void telemetryClose(TelemetryRing* r) {
+    if (r->hdr) munmap(r->hdr, r->bytes);
+    memset(r, 0, sizeof(*r));
+}
+
+#endif
+
+int telemetryRead(const TelemetryRing* r, uint64_t* next, TelemetryEvent* out, uint64_t* lost) {
+    for (;;) {
+        uint64_t head = r->hdr->head.load(std::memory_order_acquire);
+        if (*next >= head) return TEL_READ_EMPTY;
+        uint64_t capacity = (uint64_t)r->mask + 1;
+        if (head - *next > capacity) {
+            *lost += head - capacity - *next;
+            *next = head - capacity;
+        }
+
+        const TelemetrySlot* s = &r->slots[*next & r->mask];
+        uint64_t expect = 2 * *next + 2;
+        uint64_t before = s->seq.load(std::memory_order_acquire);
+        if (before < expect) {
+            // 写入方已领到序号但还没写完；它要是写到一半退出了，这个槽永远写不完，积压半圈后不再等
+            if (head - *next <= capacity / 2) return TEL_READ_EMPTY;
+            (*lost)++;
+            (*next)++;
+            continue;
+        }
+        uint64_t words[TELEMETRY_WORDS];
+        for (int i = 0; i < TELEMETRY_WORDS; i++) words[i] = s->words[i].load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = s->seq.load(std::memory_order_relaxed);
+        if (before == expect && after == expect) {
+            memcpy(out, words, sizeof(words));
+            (*next)++;
+            return TEL_READ_OK;
+        }
+        // 读的过程中这个槽被新一圈覆盖了，跳过它
+        (*lost)++;
+        (*next)++;
+    }
+}
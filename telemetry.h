@@ -0,0 +1,85 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include "scoring.h"
+
+//实时事件广播：游戏把对局事件写进一块命名共享内存里的环形缓冲区，观战/看板程序在别的进程里读。
+//多个游戏进程可以写同一个环；写入方从不等待读者，环满时直接覆盖最旧的事件，
+//读者落后太多时跳过被覆盖的部分并记下丢了多少
+
+const char* const TELEMETRY_NAME = "wordle_telemetry";
+const uint32_t TELEMETRY_SLOTS = 4096;     // 必须是 2 的幂
+
+enum {
+    TEL_GAME_START = 1,     // 开局（不含答案）
+    TEL_GUESS,              // 提交了一行：word 为猜测词，patterns 为各盘面的反馈
+    TEL_INVALID,            // 提交了不合法的词（不在词库或违反困难模式）
+    TEL_HINT,               // 使用了提示：word 为建议的词，可能为空
+    TEL_GAME_WON,           // 对局结束：word 为（第一个盘面的）答案
+    TEL_GAME_LOST,
+};
+
+struct TelemetryEvent {
+    uint64_t session;       // 游戏进程启动时随机生成
+    uint32_t time_ms;
+    uint8_t kind;           // TEL_*
+    uint8_t mode;
+    uint8_t attempt;        // 事件发生后已猜的次数
+    uint8_t board_count;
+    char word[24];          // UTF-8
+    uint8_t patterns[MAX_BOARDS];
+};
+
+//一个槽正好一个缓存行：seq 为 2 * 序号 + 1 表示正在写，2 * 序号 + 2 表示已写完。
+//内容按 8 字节的原子字存放，读者读到一半被覆盖时对比前后两次 seq 就能发现
+const int TELEMETRY_WORDS = sizeof(TelemetryEvent) / sizeof(uint64_t);
+struct alignas(64) TelemetrySlot {
+    std::atomic<uint64_t> seq;
+    std::atomic<uint64_t> words[TELEMETRY_WORDS];
+};
+static_assert(sizeof(TelemetryEvent) % sizeof(uint64_t) == 0 && sizeof(TelemetrySlot) == 64, "一个槽一个缓存行");
+
+struct TelemetryHeader {
+    char magic[8];
+    uint32_t capacity;
+    uint32_t slot_size;
+    alignas(64) std::atomic<uint64_t> head;    // 下一个要写的序号
+};
+
+//共享内存的映射，hdr 为空表示没有打开（此时写入什么也不做）
+struct TelemetryRing {
+    TelemetryHeader* hdr;
+    TelemetrySlot* slots;
+    uint32_t mask;
+    size_t bytes;
+    void* handle;           // Windows 下的映射句柄
+};
+
+//写入方：打开已有的环，没有就新建。失败返回 0，游戏照常运行只是不广播
+int telemetryCreate(TelemetryRing* r, const char* name, uint32_t capacity);
+//读者：只打开已有的环，不存在时返回 0
+int telemetryOpen(TelemetryRing* r, const char* name);
+void telemetryClose(TelemetryRing* r);
+
+//写入一个事件，不加锁也不等待
+inline void telemetryPush(TelemetryRing* r, const TelemetryEvent* e) {
+    if (!r->hdr) return;
+    uint64_t seq = r->hdr->head.fetch_add(1, std::memory_order_relaxed);
+    TelemetrySlot* s = &r->slots[seq & r->mask];
+    uint64_t words[TELEMETRY_WORDS];
+    memcpy(words, e, sizeof(words));
+    s->seq.store(2 * seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < TELEMETRY_WORDS; i++) s->words[i].store(words[i], std::memory_order_relaxed);
+    s->seq.store(2 * seq + 2, std::memory_order_release);
+}
+
+enum { TEL_READ_EMPTY, TEL_READ_OK };
+//读者从序号 *next 读一个事件。已经被覆盖的事件跳过并累加到 *lost；
+//下一个事件还没写完或还没写时返回 TEL_READ_EMPTY，稍后再试
+int telemetryRead(const TelemetryRing* r, uint64_t* next, TelemetryEvent* out, uint64_t* lost);
+//当前已经写到的序号，读者想从“现在”开始看时用它初始化 next
+inline uint64_t telemetryHead(const TelemetryRing* r) {
+    return r->hdr->head.load(std::memory_order_acquire);
+}
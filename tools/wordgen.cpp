@@ -0,0 +1,142 @@
+// 构建期词库编译器：把 words.txt 编译成 words_table.h（字母表、排序去重后的单词、DAWG、字母频率表、出题权重）。
+// 词库中有不合法的行时报错退出，让构建失败，而不是在运行时悄悄跳过。
+//
+//   wordgen words.txt words_table.h
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "dictionary.h"
+
+//逐行严格校验：空行和 # 开头的注释行忽略，其余必须恰好是 WORD_LENGTH 个字母（UTF-8，可含非英文字母），
+//后面可以跟一个非负的权重
+static int readStrict(const char* path, std::vector<uint32_t>& codes, std::vector<float>& weights, int* has_weights) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        fprintf(stderr, "%s: 无法打开\n", path);
+        return 0;
+    }
+    std::vector<char> text;
+    char buf[1 << 16];
+    size_t got;
+    while ((got = fread(buf, 1, sizeof(buf), fp)) > 0) text.insert(text.end(), buf, buf + got);
+    fclose(fp);
+
+    std::vector<size_t> bad;
+    dictParseText(text.data(), text.size(), codes, &weights, has_weights, &bad);
+    // 报错时才需要行号，从头数换行即可
+    size_t scanned = 0;
+    int line_no = 1;
+    for (size_t off : bad) {
+        for (; scanned < off; scanned++) line_no += text[scanned] == '\n';
+        size_t end = off;
+        while (end < text.size() && text[end] != '\n' && text[end] != '\r') end++;
+        fprintf(stderr, "%s:%d: 不合法的单词 \"%.*s\"（需要 %d 个字母，可跟一个非负权重）\n",
+                path, line_no, (int)(end - off), &text[off], WORD_LENGTH);
+    }
+    return bad.empty();
+}
+
+static void writeArray(FILE* out, const char* decl, const uint32_t* data, size_t n) {
+    fprintf(out, "%s = {", decl);
+    for (size_t i = 0; i < n; i++) {
+        fprintf(out, "%s%u,", i % 16 ? " " : "\n    ", data[i]);
+    }
+    fprintf(out, "\n};\n\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc != 3) {
+        fprintf(stderr, "用法: wordgen words.txt words_table.h\n");
+        return 2;
+    }
+    std::vector<uint32_t> codes;
+    std::vector<float> weights;
+    int has_weights;
+    if (!readStrict(argv[1], codes, weights, &has_weights)) return 1;
+    size_t raw = codes.size() / WORD_LENGTH;
+
+    Alphabet a;
+    if (!alphabetBuild(&a, codes.data(), codes.size())) {
+        fprintf(stderr, "%s: 词库用到的字母超过 %d 个\n", argv[1], MAX_ALPHABET);
+        return 1;
+    }
+    std::vector<uint8_t> words(codes.size());
+    alphabetMapCodes(&a, codes.data(), codes.size(), words.data());
+    Dictionary d;
+    dictBuild(&d, &a, words, has_weights ? &weights : nullptr);
+    if (d.count == 0) {
+        fprintf(stderr, "%s: 词库为空\n", argv[1]);
+        return 1;
+    }
+    if ((size_t)d.count != raw) {
+        fprintf(stderr, "%s: 注意：去掉了 %zu 个重复单词\n", argv[1], raw - d.count);
+    }
+
+    FILE* out = fopen(argv[2], "w");
+    if (!out) {
+        fprintf(stderr, "%s: 无法写入\n", argv[2]);
+        return 1;
+    }
+    fprintf(out, "// 由 wordgen 根据 words.txt 生成，请勿手动修改\n");
+    fprintf(out, "#pragma once\n#include \"dictionary.h\"\n\n");
+    fprintf(out, "constexpr int EMBEDDED_WORD_COUNT = %d;\n", d.count);
+    fprintf(out, "constexpr uint32_t EMBEDDED_ROOT = %u;\n", d.root);
+    fprintf(out, "constexpr uint64_t EMBEDDED_HASH = 0x%016llXull;\n", (unsigned long long)d.hash);
+    // 字母表按字节转义输出，不依赖编译器的源文件编码
+    fprintf(out, "constexpr const char* EMBEDDED_ALPHABET = \"");
+    for (int i = 0; i < a.size; i++) {
+        for (const char* p = a.symbols[i]; *p; p++) {
+            if ((unsigned char)*p < 0x80) fputc(*p, out);
+            else fprintf(out, "\\x%02X\"\"", (unsigned char)*p);
+        }
+    }
+    fprintf(out, "\";\n\n");
+
+    fprintf(out, "constexpr uint8_t EMBEDDED_LETTERS[] = {");
+    for (size_t i = 0; i < d.letters.size(); i++) {
+        fprintf(out, "%s%u,", i % 20 ? " " : "\n    ", d.letters[i]);
+    }
+    fprintf(out, "\n};\n\n");
+
+    fprintf(out, "constexpr DawgNode EMBEDDED_NODES[] = {");
+    for (size_t i = 0; i < d.nodes.size(); i++) {
+        fprintf(out, "%s{%lluull, %u, %u},", i % 4 ? " " : "\n    ",
+                (unsigned long long)d.nodes[i].mask, d.nodes[i].first, d.nodes[i].count);
+    }
+    fprintf(out, "\n};\n\n");
+
+    writeArray(out, "constexpr uint32_t EMBEDDED_EDGES[]", d.edges.data(), d.edges.size());
+
+    fprintf(out, "constexpr uint32_t EMBEDDED_POS_FREQ[WORD_LENGTH][MAX_ALPHABET] = {");
+    for (int p = 0; p < WORD_LENGTH; p++) {
+        fprintf(out, "\n    {");
+        for (int c = 0; c < a.size; c++) fprintf(out, "%s%u", c ? ", " : "", d.pos_freq[p][c]);
+        fprintf(out, "},");
+    }
+    fprintf(out, "\n};\n\n");
+    writeArray(out, "constexpr uint32_t EMBEDDED_LETTER_FREQ[MAX_ALPHABET]", d.letter_freq, a.size);
+
+    // 权重按科学计数法输出，整数权重也不会被当成整型常量
+    if (has_weights) {
+        fprintf(out, "constexpr float EMBEDDED_WEIGHTS[] = {");
+        for (size_t i = 0; i < d.weights.size(); i++) {
+            fprintf(out, "%s%.8e,", i % 6 ? " " : "\n    ", d.weights[i]);
+        }
+        fprintf(out, "\n};\n\n");
+    }
+
+    fprintf(out, "constexpr DictTable EMBEDDED_DICT = {\n");
+    fprintf(out, "    EMBEDDED_WORD_COUNT, EMBEDDED_LETTERS,\n");
+    fprintf(out, "    EMBEDDED_NODES, (int)(sizeof(EMBEDDED_NODES) / sizeof(EMBEDDED_NODES[0])),\n");
+    fprintf(out, "    EMBEDDED_EDGES, (int)(sizeof(EMBEDDED_EDGES) / sizeof(EMBEDDED_EDGES[0])),\n");
+    fprintf(out, "    EMBEDDED_ROOT, EMBEDDED_HASH, EMBEDDED_POS_FREQ, EMBEDDED_LETTER_FREQ, EMBEDDED_ALPHABET,\n");
+    fprintf(out, "    %s,\n", has_weights ? "EMBEDDED_WEIGHTS" : "nullptr");
+    fprintf(out, "};\n");
+
+    if (fclose(out) != 0) {
+        fprintf(stderr, "%s: 写入失败\n", argv[2]);
+        remove(argv[2]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+// 对局档案分析：读取游戏写下的 games.warc，按玩家/时间/模式筛选后统计。
+// 输出胜率与猜测分布、最常用的开局词、最难的答案，以及每项扫描用的时间。
+//
+//   wordle_archive [--file games.warc] [--dict words.txt] [--player 名字] [--days N]
+//                  [--mode classic|hard|daily|absurdle] [--top 10]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "dictionary.h"
+#include "game_archive.h"
+
+//与游戏里的 MODE_* 顺序一致
+enum { MODE_CLASSIC, MODE_ABSURDLE, MODE_MULTI, MODE_DAILY };
+const int FAIL_SCORE = MAX_ATTEMPTS + 1;    // 失败按多猜一次计分
+
+static double elapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+}
+
+static int parseMode(const char* name, uint32_t* kinds) {
+    if (strcmp(name, "classic") == 0) *kinds = archiveKind(MODE_CLASSIC, 0);
+    else if (strcmp(name, "hard") == 0) *kinds = archiveKind(MODE_CLASSIC, 1);
+    else if (strcmp(name, "daily") == 0) *kinds = archiveKind(MODE_DAILY, 0) | archiveKind(MODE_DAILY, 1);
+    else if (strcmp(name, "absurdle") == 0) *kinds = archiveKind(MODE_ABSURDLE, 0) | archiveKind(MODE_ABSURDLE, 1);
+    else return 0;
+    return 1;
+}
+
+static void usage() {
+    fprintf(stderr, "用法: wordle_archive [--file games.warc] [--dict words.txt] [--player 名字] [--days N]\n"
+                    "                      [--mode classic|hard|daily|absurdle] [--top 10]\n");
+}
+
+int main(int argc, char** argv) {
+    const char* path = "games.warc";
+    const char* dict_path = "words.txt";
+    ArchiveFilter f = { 0, 0, 0, 0 };
+    int top = 10;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--file") == 0 && i + 1 < argc) path = argv[++i];
+        else if (strcmp(argv[i], "--dict") == 0 && i + 1 < argc) dict_path = argv[++i];
+        else if (strcmp(argv[i], "--player") == 0 && i + 1 < argc) f.player = playerIdFromName(argv[++i]);
+        else if (strcmp(argv[i], "--days") == 0 && i + 1 < argc) f.since = (int64_t)time(0) - atoi(argv[++i]) * 86400LL;
+        else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc && parseMode(argv[i + 1], &f.kinds)) i++;
+        else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) top = atoi(argv[++i]);
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (top < 1) top = 1;
+
+    Dictionary dict;
+    if (!dictLoadFile(&dict, dict_path) || dict.count == 0) {
+        fprintf(stderr, "无法读取词库：%s\n", dict_path);
+        return 1;
+    }
+    GameArchive archive;
+    auto t0 = std::chrono::steady_clock::now();
+    archiveOpen(&archive, path);
+    printf("档案 %s：%llu 局，%d 块，读取 %.1f ms\n", path, (unsigned long long)archive.games,
+           (int)archive.blocks.size(), elapsedMs(t0));
+
+    t0 = std::chrono::steady_clock::now();
+    Statistics st;
+    archiveStats(&archive, &f, &st);
+    printf("\n筛选后 %d 局，猜中 %d 局（%.1f%%），最大连胜 %d（%.1f ms）\n", st.games_played, st.games_won,
+           st.games_played ? st.games_won * 100.0 / st.games_played : 0.0, st.max_streak, elapsedMs(t0));
+    for (int k = 0; k < MAX_ATTEMPTS; k++) printf("  %d 次: %d\n", k + 1, st.guess_distribution[k]);
+
+    // 开局词与答案只统计按当前词库记录的对局
+    t0 = std::chrono::steady_clock::now();
+    std::vector<uint32_t> counts(dict.count);
+    archiveOpeners(&archive, &dict, &f, counts.data());
+    double opener_ms = elapsedMs(t0);
+    std::vector<int> order(dict.count);
+    for (int i = 0; i < dict.count; i++) order[i] = i;
+    int shown = std::min(top, dict.count);
+    std::partial_sort(order.begin(), order.begin() + shown, order.end(),
+                      [&](int a, int b) { return counts[a] != counts[b] ? counts[a] > counts[b] : a < b; });
+    printf("\n最常用的开局词（%.1f ms）\n", opener_ms);
+    char text[WORD_TEXT_MAX];
+    for (int i = 0; i < shown && counts[order[i]] > 0; i++) {
+        alphabetDecode(&dict.alphabet, dictWord(&dict, order[i]), text);
+        printf("  %-8s %u\n", text, counts[order[i]]);
+    }
+
+    // 最难的答案：平均得分最高的，至少出现过 3 局才参与排名
+    const int K = MAX_ATTEMPTS + 1;
+    t0 = std::chrono::steady_clock::now();
+    std::vector<uint32_t> dist((size_t)dict.count * K);
+    archiveTargetDistribution(&archive, &dict, &f, dist.data());
+    double dist_ms = elapsedMs(t0);
+    std::vector<float> avg(dict.count, -1.0f);
+    std::vector<int> hard;
+    for (int w = 0; w < dict.count; w++) {
+        const uint32_t* row = &dist[(size_t)w * K];
+        uint32_t n = 0, score = row[0] * FAIL_SCORE;
+        for (int k = 0; k < K; k++) n += row[k];
+        for (int k = 1; k < K; k++) score += row[k] * k;
+        if (n < 3) continue;
+        avg[w] = (float)score / n;
+        hard.push_back(w);
+    }
+    shown = std::min(top, (int)hard.size());
+    std::partial_sort(hard.begin(), hard.begin() + shown, hard.end(),
+                      [&](int a, int b) { return avg[a] != avg[b] ? avg[a] > avg[b] : a < b; });
+    printf("\n最难的答案（%.1f ms）\n", dist_ms);
+    for (int i = 0; i < shown; i++) {
+        const uint32_t* row = &dist[(size_t)hard[i] * K];
+        alphabetDecode(&dict.alphabet, dictWord(&dict, hard[i]), text);
+        printf("  %-8s 平均 %.2f，失败 %u\n", text, avg[hard[i]], row[0]);
+    }
+    return 0;
+}
@@ -0,0 +1,288 @@
+// 每日一题批量生成：用参考策略在普通、困难两种规则下模拟解每个候选答案，给出难度，
+// 再按难度分层排成每周难度相近的排期，写成游戏直接按日期查表的 daily.bin。
+//
+//   wordle_daily [--dict words.txt] [--out daily.bin] [--start 2026-01-01] [--days 365]
+//                [--strategies first,freq,entropy] [--seed 1] [--threads N] [--report 难度.csv]
+//
+// 难度 = 所有参考策略、两种规则下的平均得分（猜测次数，失败记 7），
+// 再加上“陷阱”项：只差一个位置的其它词越多（如 _IGHT 一族），困难模式下越容易一个个试到失败。
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "dictionary.h"
+#include "solver.h"
+#include "opening_book.h"
+#include "daily.h"
+
+const int FAIL_SCORE = MAX_ATTEMPTS + 1;
+const double TRAP_WEIGHT = 0.25;    // 陷阱项：TRAP_WEIGHT * log2(1 + 只差一个位置的词数)
+const int STRATA = 7;               // 按难度分成 7 层，每周每层一个
+
+//一个候选答案的模拟结果
+struct Rating {
+    uint32_t word;
+    double mean;          // 平均得分（失败记 FAIL_SCORE）
+    double fail_rate;
+    double hard_extra;    // 困难模式比普通模式平均多用的得分
+    int trap;             // 只差一个位置的其它词数
+    double difficulty;
+};
+
+//只差一个位置的词数：每个位置把该位换成通配符后分组，组内其它词都算邻居
+static void countTraps(const Dictionary* d, std::vector<int>& trap) {
+    trap.assign(d->count, 0);
+    std::vector<std::pair<uint64_t, uint32_t>> keys(d->count);
+    for (int p = 0; p < WORD_LENGTH; p++) {
+        for (int i = 0; i < d->count; i++) {
+            const uint8_t* w = dictWord(d, (uint32_t)i);
+            uint64_t key = 0;
+            for (int k = 0; k < WORD_LENGTH; k++) key = (key << 7) | (k == p ? 127u : w[k]);
+            keys[i] = { key, (uint32_t)i };
+        }
+        std::sort(keys.begin(), keys.end());
+        for (size_t a = 0, b; a < keys.size(); a = b) {
+            for (b = a + 1; b < keys.size() && keys[b].first == keys[a].first; b++) {}
+            for (size_t k = a; k < b; k++) trap[keys[k].second] += (int)(b - a - 1);
+        }
+    }
+}
+
+static uint64_t mix(uint64_t x) {
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+static int parseDate(const char* s, int32_t* day_number) {
+    int y, m, d;
+    if (sscanf(s, "%d-%d-%d", &y, &m, &d) != 3 || m < 1 || m > 12 || d < 1 || d > 31) return 0;
+    *day_number = dailyDayNumber(y, m, d);
+    return 1;
+}
+
+static void usage() {
+    fprintf(stderr, "用法: wordle_daily [--dict words.txt] [--out daily.bin] [--start YYYY-MM-DD] [--days N]\n"
+                    "                   [--strategies a,b,...] [--seed S] [--threads N] [--report 文件.csv]\n策略:\n");
+    for (int i = 0; i < STRATEGY_COUNT; i++) {
+        fprintf(stderr, "  %-8s %s\n", STRATEGIES[i].name, STRATEGIES[i].description);
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* dict_path = "words.txt";
+    const char* out_path = "daily.bin";
+    const char* strategy_list = "first,freq,entropy";
+    const char* report_path = nullptr;
+    int days = 365;
+    uint64_t seed = 1;
+    int threads = (int)std::thread::hardware_concurrency();
+    time_t now = time(0);
+    struct tm* local = localtime(&now);
+    int32_t start_day = dailyDayNumber(local->tm_year + 1900, local->tm_mon + 1, local->tm_mday);
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--dict") == 0 && i + 1 < argc) dict_path = argv[++i];
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "--days") == 0 && i + 1 < argc) days = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--strategies") == 0 && i + 1 < argc) strategy_list = argv[++i];
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 0);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--report") == 0 && i + 1 < argc) report_path = argv[++i];
+        else if (strcmp(argv[i], "--start") == 0 && i + 1 < argc) {
+            if (!parseDate(argv[++i], &start_day)) {
+                fprintf(stderr, "日期格式应为 YYYY-MM-DD：%s\n", argv[i]);
+                return 2;
+            }
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (days < 1) days = 1;
+
+    std::vector<const Strategy*> refs;
+    char buf[256];
+    snprintf(buf, sizeof(buf), "%s", strategy_list);
+    for (char* name = strtok(buf, ","); name; name = strtok(nullptr, ",")) {
+        const Strategy* st = findStrategy(name);
+        if (!st) {
+            fprintf(stderr, "未知策略：%s\n", name);
+            usage();
+            return 2;
+        }
+        if (std::find(refs.begin(), refs.end(), st) == refs.end()) refs.push_back(st);
+    }
+    if (refs.empty()) {
+        usage();
+        return 2;
+    }
+
+    Dictionary dict;
+    if (!dictLoadFile(&dict, dict_path) || dict.target_count == 0) {
+        fprintf(stderr, "无法读取词库：%s\n", dict_path);
+        return 1;
+    }
+
+    // 候选答案：权重 > 0 的词（没有权重时为全部）
+    const float* weights = dictWeights(&dict);
+    std::vector<uint32_t> candidates;
+    for (int i = 0; i < dict.count; i++) {
+        if (!weights || weights[i] > 0) candidates.push_back((uint32_t)i);
+    }
+    if (weights && candidates.empty()) {
+        for (int i = 0; i < dict.count; i++) candidates.push_back((uint32_t)i);
+    }
+    int n = (int)candidates.size();
+    if (days > n) {
+        fprintf(stderr, "注意：只有 %d 个候选答案，排期缩短为 %d 天\n", n, n);
+        days = n;
+    }
+
+    // 熵策略每局的前两步都一样，两种规则各先建一份开局库
+    OpeningBook books[2];
+    for (int h = 0; h < 2; h++) openingBuild(&books[h], &dict, h);
+
+    std::vector<int> trap;
+    countTraps(&dict, trap);
+
+    // 每个线程领取一段候选词，每个词跑完所有参考策略的两种规则
+    std::vector<Rating> ratings(n);
+    std::atomic<int> next(0), finished(0);
+    const int chunk = 16;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            SolverScratch scratch[2];
+            for (int h = 0; h < 2; h++) {
+                solverInitScratch(&scratch[h], &dict, 0);
+                scratch[h].book = &books[h];
+            }
+            for (;;) {
+                int begin = next.fetch_add(chunk);
+                if (begin >= n) break;
+                int end = std::min(begin + chunk, n);
+                for (int i = begin; i < end; i++) {
+                    uint32_t w = candidates[i];
+                    double score[2] = {0, 0};
+                    int fails = 0;
+                    for (int h = 0; h < 2; h++) {
+                        for (size_t s = 0; s < refs.size(); s++) {
+                            // 随机策略的种子只由 seed、答案和策略决定，结果可复现
+                            scratch[h].rng = mix(seed ^ ((uint64_t)w << 8) ^ (s << 1) ^ h);
+                            int r = solveGame(&dict, refs[s], w, h, MAX_ATTEMPTS, &scratch[h], nullptr);
+                            score[h] += r ? r : FAIL_SCORE;
+                            fails += r == 0;
+                        }
+                    }
+                    int runs = 2 * (int)refs.size();
+                    Rating* rt = &ratings[i];
+                    rt->word = w;
+                    rt->mean = (score[0] + score[1]) / runs;
+                    rt->fail_rate = (double)fails / runs;
+                    rt->hard_extra = (score[1] - score[0]) / refs.size();
+                    rt->trap = trap[w];
+                    rt->difficulty = rt->mean + TRAP_WEIGHT * log2(1.0 + rt->trap);
+                }
+                finished.fetch_add(end - begin);
+            }
+        });
+    }
+    auto started = std::chrono::steady_clock::now();
+    while (finished.load() < n) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        fprintf(stderr, "\r[%d / %d] %5.1f%%   ", finished.load(), n, 100.0 * finished.load() / n);
+    }
+    for (auto& w : workers) w.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    fprintf(stderr, "\n");
+
+    if (report_path) {
+        FILE* fp = fopen(report_path, "w");
+        if (!fp) {
+            fprintf(stderr, "无法写入：%s\n", report_path);
+            return 1;
+        }
+        fprintf(fp, "word,mean,fail_rate,hard_extra,trap,difficulty\n");
+        char word[WORD_LENGTH * 4 + 1];
+        for (const Rating& rt : ratings) {
+            alphabetDecode(&dict.alphabet, dictWord(&dict, rt.word), word);
+            fprintf(fp, "%s,%.4f,%.4f,%.4f,%d,%.4f\n", word, rt.mean, rt.fail_rate, rt.hard_extra, rt.trap, rt.difficulty);
+        }
+        fclose(fp);
+    }
+
+    // 选出 days 个答案：按词频权重不放回抽样（没有权重时等概率）
+    uint64_t rng = seed;
+    std::vector<Rating> chosen;
+    if (days == n) {
+        chosen = ratings;
+    } else {
+        std::vector<float> w(n);
+        for (int i = 0; i < n; i++) w[i] = weights ? weights[candidates[i]] : 1.0f;
+        SessionSampler sampler = {};
+        samplerReset(&sampler, w.data(), n, 0);
+        for (int k = 0; k < days; k++) chosen.push_back(ratings[samplerNext(&sampler, w.data(), &rng)]);
+    }
+
+    // 按难度排序后切成 7 层，第 k 层的词蛇形分给各周（偶数层从第一周往后，奇数层倒过来），
+    // 每周各层一个词，周与周之间的难度总和相近
+    std::sort(chosen.begin(), chosen.end(), [](const Rating& a, const Rating& b) {
+        return a.difficulty != b.difficulty ? a.difficulty < b.difficulty : a.word < b.word;
+    });
+    int weeks = (days + STRATA - 1) / STRATA;
+    std::vector<std::vector<int>> week_items(weeks);
+    for (int i = 0; i < days; i++) {
+        int layer = i / weeks, j = i % weeks;
+        week_items[layer % 2 == 0 ? j : weeks - 1 - j].push_back(i);
+    }
+    // 周的先后与周内各天的顺序都打乱；不满 7 天的周放在最后，前面的周都和日历周对齐
+    std::vector<int> order;
+    for (int k = 0; k < weeks; k++) order.push_back(k);
+    std::stable_partition(order.begin(), order.end(), [&](int k) { return (int)week_items[k].size() == STRATA; });
+    int full = 0;
+    while (full < weeks && (int)week_items[order[full]].size() == STRATA) full++;
+    for (int k = full - 1; k > 0; k--) std::swap(order[k], order[sampleRandom(&rng) % (uint64_t)(k + 1)]);
+
+    DailySchedule sched;
+    sched.dict_hash = dict.hash;
+    sched.count = dict.count;
+    sched.start_day = start_day;
+    std::vector<double> week_mean;
+    for (int k : order) {
+        std::vector<int>& items = week_items[k];
+        for (int a = (int)items.size() - 1; a > 0; a--) std::swap(items[a], items[sampleRandom(&rng) % (uint64_t)(a + 1)]);
+        double sum = 0;
+        for (int i : items) {
+            sched.targets.push_back(chosen[i].word);
+            sched.difficulty.push_back((uint16_t)std::min(65535.0, chosen[i].difficulty * 100 + 0.5));
+            sum += chosen[i].difficulty;
+        }
+        week_mean.push_back(sum / items.size());
+    }
+    if (!dailySave(&sched, out_path)) {
+        fprintf(stderr, "无法写入：%s\n", out_path);
+        return 1;
+    }
+
+    double lo = 1e9, hi = 0, all = 0;
+    for (int k = 0; k < full; k++) {
+        lo = std::min(lo, week_mean[k]);
+        hi = std::max(hi, week_mean[k]);
+    }
+    for (const Rating& rt : chosen) all += rt.difficulty;
+    int y0, m0, d0, y1, m1, d1;
+    dailyDate(start_day, &y0, &m0, &d0);
+    dailyDate(start_day + days - 1, &y1, &m1, &d1);
+    printf("候选答案: %d  参考策略: %d 个 x 普通/困难  线程: %d  用时: %.1f 秒\n", n, (int)refs.size(), threads, elapsed);
+    printf("排期: %04d-%02d-%02d 至 %04d-%02d-%02d 共 %d 天 -> %s\n", y0, m0, d0, y1, m1, d1, days, out_path);
+    printf("平均难度: %.3f  整周平均难度: %.3f ~ %.3f（%d 个整周）\n", all / days, full ? lo : 0.0, full ? hi : 0.0, full);
+    return 0;
+}
@@ -0,0 +1,210 @@
+// 策略评测：用指定策略把词库里每个词都当作答案跑一遍，统计猜测次数分布。
+// 多线程并行，定期写断点文件，中断后用同样的参数重新运行即可续跑。
+// --openers 把第一步固定为给定的词，对每个开局词都跑一遍（开局词 × 答案）。
+// --shard i/N 只跑第 i 个分片，结果写入 --out，各分片可以在不同机器上跑，最后用 wordle_merge 合并。
+//
+//   wordle_eval [--dict words.txt] [--strategy entropy] [--hard] [--threads N]
+//               [--checkpoint eval.ckpt] [--checkpoint-every 60] [--opening opening.bin]
+//               [--openers all|CRANE,SLATE] [--shard i/N --out part.wsw] [--top 10]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "dictionary.h"
+#include "solver.h"
+#include "opening_book.h"
+#include "sweep.h"
+
+//断点：参数、词库与分片都一致才使用，返回已完成的格子数，否则返回 -1
+static int64_t loadCheckpoint(const char* path, const SweepPart* expect, std::vector<std::atomic<int8_t>>& results) {
+    SweepPart saved;
+    if (!sweepLoad(&saved, path) || !sweepSameRun(&saved, expect) || saved.h.shard != expect->h.shard) return -1;
+    int64_t done = 0;
+    for (size_t k = 0; k < saved.results.size(); k++) {
+        results[k].store(saved.results[k], std::memory_order_relaxed);
+        if (saved.results[k] != SWEEP_PENDING) done++;
+    }
+    return done;
+}
+
+static void saveResults(const char* path, SweepPart* part, const std::vector<std::atomic<int8_t>>& results) {
+    for (size_t k = 0; k < results.size(); k++) part->results[k] = results[k].load(std::memory_order_relaxed);
+    if (!sweepSave(part, path)) fprintf(stderr, "写入 %s 失败\n", path);
+}
+
+//--openers：all 为词库中每个词，否则为逗号分隔的单词
+static int parseOpeners(const Dictionary* d, const char* spec, std::vector<uint32_t>& out) {
+    if (strcmp(spec, "all") == 0) {
+        for (int i = 0; i < d->count; i++) out.push_back((uint32_t)i);
+        return 1;
+    }
+    char buf[1024];
+    snprintf(buf, sizeof(buf), "%s", spec);
+    for (char* tok = strtok(buf, ","); tok; tok = strtok(nullptr, ",")) {
+        uint8_t w[WORD_LENGTH];
+        int id = alphabetEncode(&d->alphabet, tok, w) ? dictIndexOf(d, w) : -1;
+        if (id < 0) {
+            fprintf(stderr, "开局词不在词库中：%s\n", tok);
+            return 0;
+        }
+        out.push_back((uint32_t)id);
+    }
+    return !out.empty();
+}
+
+static void usage() {
+    fprintf(stderr, "用法: wordle_eval [--dict words.txt] [--strategy 名称] [--hard] [--threads N]\n"
+                    "                  [--checkpoint 文件] [--checkpoint-every 秒] [--opening 开局库文件]\n"
+                    "                  [--openers all|单词,单词] [--shard i/N --out 结果文件] [--top 10]\n策略:\n");
+    for (int i = 0; i < STRATEGY_COUNT; i++) {
+        fprintf(stderr, "  %-8s %s\n", STRATEGIES[i].name, STRATEGIES[i].description);
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* dict_path = "words.txt";
+    const char* strategy_name = "entropy";
+    const char* checkpoint_path = nullptr;
+    const char* opening_path = nullptr;
+    const char* openers_spec = nullptr;
+    const char* out_path = nullptr;
+    int shard = 0, shards = 1;
+    int top = 10;
+    int hard_mode = 0;
+    int threads = (int)std::thread::hardware_concurrency();
+    int checkpoint_every = 60;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--dict") == 0 && i + 1 < argc) dict_path = argv[++i];
+        else if (strcmp(argv[i], "--strategy") == 0 && i + 1 < argc) strategy_name = argv[++i];
+        else if (strcmp(argv[i], "--hard") == 0) hard_mode = 1;
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) checkpoint_path = argv[++i];
+        else if (strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc) checkpoint_every = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--opening") == 0 && i + 1 < argc) opening_path = argv[++i];
+        else if (strcmp(argv[i], "--openers") == 0 && i + 1 < argc) openers_spec = argv[++i];
+        else if (strcmp(argv[i], "--shard") == 0 && i + 1 < argc && sscanf(argv[i + 1], "%d/%d", &shard, &shards) == 2) i++;
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) top = atoi(argv[++i]);
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (shards < 1 || shard < 0 || shard >= shards) {
+        fprintf(stderr, "分片号应为 i/N，0 <= i < N\n");
+        return 2;
+    }
+    if (shards > 1 && !out_path) {
+        fprintf(stderr, "分片运行需要用 --out 指定结果文件\n");
+        return 2;
+    }
+
+    const Strategy* st = findStrategy(strategy_name);
+    if (!st) {
+        fprintf(stderr, "未知策略：%s\n", strategy_name);
+        usage();
+        return 2;
+    }
+    Dictionary dict;
+    if (!dictLoadFile(&dict, dict_path) || dict.count == 0) {
+        fprintf(stderr, "无法读取词库：%s\n", dict_path);
+        return 1;
+    }
+
+    // 熵策略的前两步查开局库，库文件不存在或过期时先生成
+    OpeningBook book;
+    if (opening_path) {
+        if (openingLoadOrBuild(&book, opening_path, &dict, hard_mode)) {
+            fprintf(stderr, "使用开局库 %s\n", opening_path);
+        } else {
+            fprintf(stderr, "已生成开局库 %s\n", opening_path);
+        }
+    }
+
+    std::vector<uint32_t> openers;
+    if (openers_spec && !parseOpeners(&dict, openers_spec, openers)) return 2;
+    SweepPart part;
+    sweepInit(&part, &dict, st->name, hard_mode, shard, shards, openers);
+    int64_t cells = (int64_t)part.results.size();
+    std::vector<std::atomic<int8_t>> results(cells);
+    for (int64_t k = 0; k < cells; k++) results[k].store(SWEEP_PENDING, std::memory_order_relaxed);
+
+    int64_t resumed = 0;
+    if (checkpoint_path) {
+        resumed = loadCheckpoint(checkpoint_path, &part, results);
+        if (resumed >= 0) {
+            fprintf(stderr, "从断点恢复：已完成 %lld / %lld\n", (long long)resumed, (long long)cells);
+        } else {
+            resumed = 0;
+        }
+    }
+
+    // 各线程按块领取本分片的格子，断点里已算完的跳过；格子数可能超过 2^32，下标与计数都用 64 位
+    std::atomic<int64_t> next(0);
+    std::atomic<int64_t> finished(0);
+    const int64_t CHUNK = 8;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            SolverScratch scratch;
+            solverInitScratch(&scratch, &dict, 0);
+            if (opening_path) scratch.book = &book;
+            for (;;) {
+                int64_t start = next.fetch_add(CHUNK);
+                if (start >= cells) break;
+                int64_t end = std::min(start + CHUNK, cells);
+                int64_t solved = 0;
+                for (int64_t k = start; k < end; k++) {
+                    if (results[k].load(std::memory_order_relaxed) != SWEEP_PENDING) continue;
+                    int64_t cell = shard + (int64_t)k * shards;
+                    uint32_t target = (uint32_t)(cell % dict.count);
+                    scratch.opener = openers.empty() ? OPENING_NONE : openers[cell / dict.count];
+                    scratch.rng = 0x5EED0000ull + cell; // 随机策略也能续跑出同样的结果，与分片方式无关
+                    int used = solveGame(&dict, st, target, hard_mode, MAX_ATTEMPTS, &scratch, nullptr);
+                    results[k].store((int8_t)used, std::memory_order_relaxed);
+                    solved++;
+                }
+                finished.fetch_add(solved);
+            }
+        });
+    }
+
+    // 主线程负责进度输出与定期写断点
+    auto begin = std::chrono::steady_clock::now();
+    auto last_checkpoint = begin;
+    int64_t remaining = cells - resumed;
+    while (finished.load() < remaining) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - begin).count();
+        int64_t done = finished.load();
+        double rate = elapsed > 0 ? done / elapsed : 0;
+        double eta = rate > 0 ? (remaining - done) / rate : 0;
+        fprintf(stderr, "\r[%lld / %lld] %5.1f%%  %.1f 局/秒  剩余约 %.0f 秒   ",
+                (long long)(resumed + done), (long long)cells, 100.0 * (resumed + done) / cells, rate, eta);
+        if (checkpoint_path && std::chrono::duration<double>(now - last_checkpoint).count() >= checkpoint_every) {
+            saveResults(checkpoint_path, &part, results);
+            last_checkpoint = now;
+        }
+    }
+    for (auto& w : workers) w.join();
+    fprintf(stderr, "\n");
+    if (checkpoint_path) saveResults(checkpoint_path, &part, results);
+    if (out_path) {
+        saveResults(out_path, &part, results);
+        fprintf(stderr, "分片 %d/%d 的结果已写入 %s\n", shard, shards, out_path);
+    }
+
+    // 只有一个分片时直接出报告，否则由 wordle_merge 合并后出报告
+    if (shards == 1) {
+        for (int64_t k = 0; k < cells; k++) part.results[k] = results[k].load(std::memory_order_relaxed);
+        sweepReport(&part, &dict, top, stdout);
+    }
+    return 0;
+}
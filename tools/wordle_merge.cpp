@@ -0,0 +1,97 @@
+// 合并 wordle_eval --shard 写出的各分片结果，输出与单机运行相同的报告。
+// 所有分片必须来自同一次评测（词库、策略、模式、开局词、分片数都相同），每个分片恰好一份且已算完。
+// 合并结果可以用 --out 存成一个文件（1 个分片），之后可以直接出报告或再参与合并。
+//
+//   wordle_merge [--dict words.txt] [--out merged.wsw] [--top 10] part0.wsw part1.wsw ...
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+#include "dictionary.h"
+#include "sweep.h"
+
+static void usage() {
+    fprintf(stderr, "用法: wordle_merge [--dict words.txt] [--out 合并结果] [--top 10] 分片文件...\n");
+}
+
+int main(int argc, char** argv) {
+    const char* dict_path = "words.txt";
+    const char* out_path = nullptr;
+    int top = 10;
+    std::vector<const char*> inputs;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--dict") == 0 && i + 1 < argc) dict_path = argv[++i];
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) top = atoi(argv[++i]);
+        else if (argv[i][0] == '-') {
+            usage();
+            return 2;
+        } else {
+            inputs.push_back(argv[i]);
+        }
+    }
+    if (inputs.empty()) {
+        usage();
+        return 2;
+    }
+
+    Dictionary dict;
+    if (!dictLoadFile(&dict, dict_path) || dict.count == 0) {
+        fprintf(stderr, "无法读取词库：%s\n", dict_path);
+        return 1;
+    }
+
+    // 第一个文件决定这次评测的参数，其余的逐个核对后填进整张表
+    SweepPart merged, part, first;
+    std::vector<int> seen;
+    int64_t pending = 0;
+    for (size_t f = 0; f < inputs.size(); f++) {
+        if (!sweepLoad(&part, inputs[f])) {
+            fprintf(stderr, "无法读取分片结果：%s\n", inputs[f]);
+            return 1;
+        }
+        if (f == 0) {
+            if (part.h.dict_hash != dict.hash || part.h.count != dict.count) {
+                fprintf(stderr, "%s 不是用这个词库算的\n", inputs[f]);
+                return 1;
+            }
+            first.h = part.h;
+            first.openers = part.openers;
+            sweepInit(&merged, &dict, part.h.strategy, part.h.hard_mode, 0, 1, part.openers);
+            seen.assign(part.h.shards, 0);
+        } else {
+            if (!sweepSameRun(&part, &first)) {
+                fprintf(stderr, "%s 与 %s 不是同一次评测\n", inputs[f], inputs[0]);
+                return 1;
+            }
+        }
+        if (seen[part.h.shard]++) {
+            fprintf(stderr, "分片 %d/%d 重复：%s\n", part.h.shard, part.h.shards, inputs[f]);
+            return 1;
+        }
+        for (size_t k = 0; k < part.results.size(); k++) {
+            merged.results[part.h.shard + k * part.h.shards] = part.results[k];
+            pending += part.results[k] == SWEEP_PENDING;
+        }
+    }
+
+    int missing = 0;
+    for (size_t s = 0; s < seen.size(); s++) {
+        if (!seen[s]) {
+            fprintf(stderr, "缺少分片 %d/%d\n", (int)s, (int)seen.size());
+            missing++;
+        }
+    }
+    if (missing || pending) {
+        if (pending) fprintf(stderr, "还有 %lld 局没有算完（分片中途停止？）\n", (long long)pending);
+        return 1;
+    }
+    fprintf(stderr, "已合并 %d 个分片，共 %lld 局\n", (int)seen.size(), (long long)sweepTotal(&merged.h));
+
+    if (out_path && !sweepSave(&merged, out_path)) {
+        fprintf(stderr, "写入 %s 失败\n", out_path);
+        return 1;
+    }
+    sweepReport(&merged, &dict, top, stdout);
+    return 0;
+}
@@ -0,0 +1,201 @@
+// 观战：读取游戏写进共享内存的事件环，实时显示所有正在进行的对局。
+// 只读共享内存，不会拖慢游戏；落后太多时跳过被覆盖的事件并提示丢了多少。
+//
+//   wordle_spectate [--name wordle_telemetry] [--from-start] [--sessions] [--interval 1000]
+//
+// 默认逐条打印事件；--sessions 为看板模式，每隔 interval 毫秒刷新一次所有会话的当前状态。
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "telemetry.h"
+
+//与游戏里的 MODE_* 顺序一致
+static const char* MODE_NAMES[] = { "经典", "对抗", "多词", "每日" };
+const uint64_t SESSION_IDLE_MS = 10 * 60 * 1000;   // 看板上超过 10 分钟没有事件的会话不再显示
+
+static const char* modeName(int mode) {
+    return mode >= 0 && mode < (int)(sizeof(MODE_NAMES) / sizeof(MODE_NAMES[0])) ? MODE_NAMES[mode] : "?";
+}
+
+//反馈画成方块：绿 = 位置正确，黄 = 存在，黑 = 不存在
+static void patternText(uint8_t pattern, char* out) {
+    int result[WORD_LENGTH];
+    decodePattern(pattern, result);
+    out[0] = '\0';
+    for (int i = 0; i < WORD_LENGTH; i++) {
+        strcat(out, result[i] == 3 ? "🟩" : result[i] == 2 ? "🟨" : "⬛");
+    }
+}
+
+static uint64_t nowMs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void printEvent(const TelemetryEvent* e) {
+    char pat[WORD_LENGTH * 4 + 1];
+    printf("[%08x] %s ", (uint32_t)e->session, modeName(e->mode));
+    switch (e->kind) {
+    case TEL_GAME_START:
+        printf("开局（%d 个词）\n", e->board_count);
+        break;
+    case TEL_GUESS:
+        printf("第 %d 行 %-8s", e->attempt, e->word);
+        for (int b = 0; b < e->board_count; b++) {
+            patternText(e->patterns[b], pat);
+            printf(" %s", pat);
+        }
+        printf("\n");
+        break;
+    case TEL_INVALID:
+        printf("无效输入 %s\n", e->word);
+        break;
+    case TEL_HINT:
+        printf("使用提示 %s\n", e->word);
+        break;
+    case TEL_GAME_WON:
+        printf("猜中！%d 次，答案 %s\n", e->attempt, e->word);
+        break;
+    case TEL_GAME_LOST:
+        printf("失败，答案 %s\n", e->word);
+        break;
+    default:
+        printf("未知事件 %d\n", e->kind);
+    }
+}
+
+//看板上一个会话的状态
+struct SessionView {
+    TelemetryEvent last_guess;
+    int mode, attempt, board_count;
+    int state;          // 0 进行中，TEL_GAME_WON / TEL_GAME_LOST
+    int games, wins, hints, invalid;
+    uint64_t seen_ms;
+};
+
+static void applyEvent(std::unordered_map<uint64_t, SessionView>& sessions, const TelemetryEvent* e, uint64_t now) {
+    SessionView& s = sessions[e->session];
+    s.mode = e->mode;
+    s.attempt = e->attempt;
+    s.board_count = e->board_count;
+    s.seen_ms = now;
+    switch (e->kind) {
+    case TEL_GAME_START:
+        s.state = 0;
+        s.last_guess.word[0] = '\0';
+        break;
+    case TEL_GUESS:
+        s.last_guess = *e;
+        break;
+    case TEL_INVALID:
+        s.invalid++;
+        break;
+    case TEL_HINT:
+        s.hints++;
+        break;
+    case TEL_GAME_WON:
+    case TEL_GAME_LOST:
+        s.state = e->kind;
+        s.games++;
+        if (e->kind == TEL_GAME_WON) s.wins++;
+        break;
+    }
+}
+
+static void drawDashboard(std::unordered_map<uint64_t, SessionView>& sessions, uint64_t now,
+                          uint64_t events, uint64_t lost, double seconds) {
+    std::vector<uint64_t> ids;
+    for (auto it = sessions.begin(); it != sessions.end();) {
+        if (now - it->second.seen_ms > SESSION_IDLE_MS) {
+            it = sessions.erase(it);
+        } else {
+            ids.push_back(it->first);
+            ++it;
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+
+    int playing = 0;
+    for (uint64_t id : ids) playing += sessions[id].state == 0;
+    printf("\033[H\033[2J");
+    printf("会话: %d（对局中 %d）  事件: %llu（%.0f/秒）  丢失: %llu\n\n", (int)ids.size(), playing,
+           (unsigned long long)events, seconds > 0 ? events / seconds : 0.0, (unsigned long long)lost);
+    printf("%-10s %-4s %-6s %-8s %-16s %-8s %s\n", "会话", "模式", "行数", "上一猜", "反馈", "状态", "局数/猜中/提示/无效");
+    char pat[WORD_LENGTH * 4 + 1];
+    for (uint64_t id : ids) {
+        const SessionView& s = sessions[id];
+        pat[0] = '\0';
+        if (s.last_guess.word[0] != '\0') patternText(s.last_guess.patterns[0], pat);
+        const char* state = s.state == TEL_GAME_WON ? "猜中" : s.state == TEL_GAME_LOST ? "失败" : "进行中";
+        printf("%08x   %-4s %-6d %-8s %-16s %-8s %d/%d/%d/%d\n", (uint32_t)id, modeName(s.mode), s.attempt,
+               s.last_guess.word, pat, state, s.games, s.wins, s.hints, s.invalid);
+    }
+    fflush(stdout);
+}
+
+static void usage() {
+    fprintf(stderr, "用法: wordle_spectate [--name wordle_telemetry] [--from-start] [--sessions] [--interval 毫秒]\n");
+}
+
+int main(int argc, char** argv) {
+    const char* name = TELEMETRY_NAME;
+    int from_start = 0;
+    int dashboard = 0;
+    int interval = 1000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--name") == 0 && i + 1 < argc) name = argv[++i];
+        else if (strcmp(argv[i], "--from-start") == 0) from_start = 1;
+        else if (strcmp(argv[i], "--sessions") == 0) dashboard = 1;
+        else if (strcmp(argv[i], "--interval") == 0 && i + 1 < argc) interval = atoi(argv[++i]);
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (interval < 50) interval = 50;
+
+    // 游戏还没启动时等它建好事件环，等到之后从头读，不漏掉第一局的开头
+    TelemetryRing ring;
+    if (!telemetryOpen(&ring, name)) {
+        fprintf(stderr, "等待游戏启动（共享内存 %s）……\n", name);
+        while (!telemetryOpen(&ring, name)) std::this_thread::sleep_for(std::chrono::seconds(1));
+        from_start = 1;
+    }
+
+    // 从环里最旧的事件或者从现在开始
+    uint64_t head = telemetryHead(&ring);
+    uint64_t capacity = (uint64_t)ring.mask + 1;
+    uint64_t next = from_start ? (head > capacity ? head - capacity : 0) : head;
+    uint64_t lost = 0, reported_lost = 0, events = 0;
+    std::unordered_map<uint64_t, SessionView> sessions;
+    uint64_t start = nowMs(), last_draw = 0;
+    TelemetryEvent e;
+    for (;;) {
+        int got = 0;
+        while (telemetryRead(&ring, &next, &e, &lost) == TEL_READ_OK) {
+            got = 1;
+            events++;
+            if (dashboard) {
+                applyEvent(sessions, &e, nowMs());
+            } else {
+                printEvent(&e);
+            }
+        }
+        uint64_t now = nowMs();
+        if (!dashboard && lost != reported_lost) {
+            printf("（落后太多，跳过了 %llu 个事件）\n", (unsigned long long)(lost - reported_lost));
+            reported_lost = lost;
+        }
+        if (dashboard && now - last_draw >= (uint64_t)interval) {
+            drawDashboard(sessions, now, events, lost, (now - start) / 1000.0);
+            last_draw = now;
+        }
+        if (!dashboard && got) fflush(stdout);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
@@ -0,0 +1,302 @@
+// 策略对战：多个策略在同一组种子上各下一遍，每个种子决定一局的答案（以及随机策略的随机数），
+// 所有策略面对完全相同的答案序列。多线程并行，输出带 95% 置信区间的排名表。
+//
+//   wordle_tourney [--dict words.txt] [--strategies first,freq,entropy] [--games 1000000] [--seed 1]
+//                  [--seed-file 文件] [--hard] [--threads N] [--opening opening.bin]
+//
+// 确定性策略同一答案总是走出同样的猜测序列，每个答案只实际模拟一次，之后直接查表，
+// 因此百万局的对战主要花在随机策略上。
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "dictionary.h"
+#include "solver.h"
+#include "opening_book.h"
+
+const int8_t RESULT_PENDING = -1;
+const int8_t RESULT_FAILED = 0;
+const int FAIL_SCORE = MAX_ATTEMPTS + 1;   // 得分：猜测次数，失败记 7
+const size_t CHUNK = 512;                   // 每次领取的局数
+
+static uint64_t splitmix64(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+//一局由一个种子决定：第一个随机数选答案，第二个作为随机策略的种子
+struct Match {
+    uint32_t target;
+    uint64_t rng;
+};
+
+static Match matchFromSeed(uint64_t seed, int dict_count) {
+    uint64_t st = seed;
+    Match m;
+    m.target = (uint32_t)(splitmix64(&st) % (uint64_t)dict_count);
+    m.rng = splitmix64(&st);
+    return m;
+}
+
+static int readSeedFile(const char* path, std::vector<uint64_t>& seeds) {
+    FILE* fp = fopen(path, "r");
+    if (!fp) return 0;
+    char line[128];
+    while (fgets(line, sizeof(line), fp)) {
+        if (line[0] == '#' || line[0] == '\n' || line[0] == '\r') continue;
+        seeds.push_back(strtoull(line, nullptr, 0));
+    }
+    fclose(fp);
+    return 1;
+}
+
+//每个策略的成绩，由各线程的局部结果合并
+struct Standing {
+    const Strategy* st;
+    long long games, wins;
+    long long guess_sum;                  // 猜中局的次数之和
+    double score_sum, score_sq;           // 得分（失败记 FAIL_SCORE）的和与平方和
+    long long distribution[MAX_ATTEMPTS];
+    double diff_mean, diff_half;          // 与第一名逐局配对的得分差及其 95% 区间半宽
+};
+
+//威尔逊区间：胜率接近 0 或 1 时仍然可靠
+static void wilson(long long k, long long n, double* lo, double* hi) {
+    const double z = 1.96;
+    if (n == 0) {
+        *lo = *hi = 0;
+        return;
+    }
+    double p = (double)k / n;
+    double denom = 1 + z * z / n;
+    double center = (p + z * z / (2.0 * n)) / denom;
+    double half = z * sqrt(p * (1 - p) / n + z * z / (4.0 * n * n)) / denom;
+    *lo = std::max(0.0, center - half);
+    *hi = std::min(1.0, center + half);
+}
+
+static double halfWidth(double sum, double sq, long long n) {
+    if (n < 2) return 0;
+    double mean = sum / n;
+    double var = (sq - n * mean * mean) / (n - 1);
+    return 1.96 * sqrt(var > 0 ? var : 0) / sqrt((double)n);
+}
+
+static int scoreOf(int8_t r) {
+    return r == RESULT_FAILED ? FAIL_SCORE : r;
+}
+
+static void usage() {
+    fprintf(stderr, "用法: wordle_tourney [--dict words.txt] [--strategies a,b,...] [--games N] [--seed S]\n"
+                    "                     [--seed-file 文件] [--hard] [--threads N] [--opening 开局库文件]\n策略:\n");
+    for (int i = 0; i < STRATEGY_COUNT; i++) {
+        fprintf(stderr, "  %-8s %s\n", STRATEGIES[i].name, STRATEGIES[i].description);
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* dict_path = "words.txt";
+    const char* strategy_list = nullptr;
+    const char* seed_path = nullptr;
+    const char* opening_path = nullptr;
+    long long games = 100000;
+    uint64_t seed = 1;
+    int hard_mode = 0;
+    int threads = (int)std::thread::hardware_concurrency();
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--dict") == 0 && i + 1 < argc) dict_path = argv[++i];
+        else if (strcmp(argv[i], "--strategies") == 0 && i + 1 < argc) strategy_list = argv[++i];
+        else if (strcmp(argv[i], "--games") == 0 && i + 1 < argc) games = atoll(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 0);
+        else if (strcmp(argv[i], "--seed-file") == 0 && i + 1 < argc) seed_path = argv[++i];
+        else if (strcmp(argv[i], "--hard") == 0) hard_mode = 1;
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--opening") == 0 && i + 1 < argc) opening_path = argv[++i];
+        else {
+            usage();
+            return 2;
+        }
+    }
+    if (threads < 1) threads = 1;
+
+    // 参赛策略，默认全部
+    std::vector<const Strategy*> entrants;
+    if (strategy_list) {
+        char buf[256];
+        snprintf(buf, sizeof(buf), "%s", strategy_list);
+        for (char* name = strtok(buf, ","); name; name = strtok(nullptr, ",")) {
+            const Strategy* st = findStrategy(name);
+            if (!st) {
+                fprintf(stderr, "未知策略：%s\n", name);
+                usage();
+                return 2;
+            }
+            if (std::find(entrants.begin(), entrants.end(), st) == entrants.end()) entrants.push_back(st);
+        }
+    } else {
+        for (int i = 0; i < STRATEGY_COUNT; i++) entrants.push_back(&STRATEGIES[i]);
+    }
+    int strategies = (int)entrants.size();
+    if (strategies == 0) {
+        usage();
+        return 2;
+    }
+
+    Dictionary dict;
+    if (!dictLoadFile(&dict, dict_path) || dict.count == 0) {
+        fprintf(stderr, "无法读取词库：%s\n", dict_path);
+        return 1;
+    }
+    OpeningBook book;
+    if (opening_path) {
+        if (openingLoadOrBuild(&book, opening_path, &dict, hard_mode)) {
+            fprintf(stderr, "使用开局库 %s\n", opening_path);
+        } else {
+            fprintf(stderr, "已生成开局库 %s\n", opening_path);
+        }
+    }
+
+    // 种子集合：文件中逐行给出，或 seed, seed + 1, ... 共 games 个
+    std::vector<uint64_t> seeds;
+    if (seed_path) {
+        if (!readSeedFile(seed_path, seeds) || seeds.empty()) {
+            fprintf(stderr, "无法读取种子文件：%s\n", seed_path);
+            return 1;
+        }
+    } else {
+        if (games < 1) games = 1;
+        seeds.resize((size_t)games);
+        for (size_t i = 0; i < seeds.size(); i++) seeds[i] = seed + i;
+    }
+    size_t total = seeds.size();
+    std::vector<Match> matches(total);
+    for (size_t i = 0; i < total; i++) matches[i] = matchFromSeed(seeds[i], dict.count);
+
+    // results[s][i]：第 s 个策略第 i 局的猜测次数；memo[s][t]：确定性策略在答案 t 上的结果
+    std::vector<std::vector<int8_t>> results(strategies, std::vector<int8_t>(total));
+    std::vector<std::vector<std::atomic<int8_t>>> memo(strategies);
+    for (int s = 0; s < strategies; s++) {
+        if (!entrants[s]->deterministic) continue;
+        memo[s] = std::vector<std::atomic<int8_t>>(dict.count);
+        for (auto& m : memo[s]) m.store(RESULT_PENDING, std::memory_order_relaxed);
+    }
+
+    // 工作单元按 (局段, 策略) 交错编号，各策略同时推进
+    size_t chunks = (total + CHUNK - 1) / CHUNK;
+    size_t units = chunks * strategies;
+    std::atomic<size_t> next(0);
+    std::atomic<long long> finished(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            SolverScratch scratch;
+            solverInitScratch(&scratch, &dict, 0);
+            if (opening_path) scratch.book = &book;
+            for (;;) {
+                size_t u = next.fetch_add(1);
+                if (u >= units) break;
+                int s = (int)(u % strategies);
+                size_t begin = (u / strategies) * CHUNK;
+                size_t end = std::min(begin + CHUNK, total);
+                const Strategy* st = entrants[s];
+                for (size_t i = begin; i < end; i++) {
+                    const Match& m = matches[i];
+                    int8_t r = st->deterministic ? memo[s][m.target].load(std::memory_order_relaxed) : RESULT_PENDING;
+                    if (r == RESULT_PENDING) {
+                        scratch.rng = m.rng;
+                        r = (int8_t)solveGame(&dict, st, m.target, hard_mode, MAX_ATTEMPTS, &scratch, nullptr);
+                        // 两个线程同时算同一个答案时结果相同，重复写入无妨
+                        if (st->deterministic) memo[s][m.target].store(r, std::memory_order_relaxed);
+                    }
+                    results[s][i] = r;
+                }
+                finished.fetch_add((long long)(end - begin));
+            }
+        });
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    long long all = (long long)total * strategies;
+    while (finished.load() < all) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        long long done = finished.load();
+        fprintf(stderr, "\r[%lld / %lld] %5.1f%%  %.0f 局/秒   ", done, all, 100.0 * done / all,
+                elapsed > 0 ? done / elapsed : 0.0);
+    }
+    for (auto& w : workers) w.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    fprintf(stderr, "\n");
+
+    // 汇总
+    std::vector<Standing> table(strategies);
+    for (int s = 0; s < strategies; s++) {
+        Standing* sd = &table[s];
+        memset(sd, 0, sizeof(*sd));
+        sd->st = entrants[s];
+        for (size_t i = 0; i < total; i++) {
+            int8_t r = results[s][i];
+            int score = scoreOf(r);
+            sd->games++;
+            sd->score_sum += score;
+            sd->score_sq += (double)score * score;
+            if (r != RESULT_FAILED) {
+                sd->wins++;
+                sd->guess_sum += r;
+                sd->distribution[r - 1]++;
+            }
+        }
+    }
+    // 按平均得分排名，并与第一名逐局配对比较（同一答案序列，配对差的区间比两个独立区间窄得多）
+    std::vector<int> order(strategies);
+    for (int s = 0; s < strategies; s++) order[s] = s;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return table[a].score_sum < table[b].score_sum; });
+    int leader = order[0];
+    for (int s = 0; s < strategies; s++) {
+        double sum = 0, sq = 0;
+        for (size_t i = 0; i < total; i++) {
+            int d = scoreOf(results[s][i]) - scoreOf(results[leader][i]);
+            sum += d;
+            sq += (double)d * d;
+        }
+        table[s].diff_mean = sum / total;
+        table[s].diff_half = halfWidth(sum, sq, (long long)total);
+    }
+
+    printf("对局: 每个策略 %zu 局  模式: %s  词数: %d  线程: %d  用时: %.1f 秒\n",
+           total, hard_mode ? "困难" : "普通", dict.count, threads, elapsed);
+    printf("得分为猜测次数，失败记 %d；区间均为 95%%\n\n", FAIL_SCORE);
+    printf("%-4s %-8s %-26s %-20s %-20s %s\n", "名次", "策略", "胜率", "平均猜测（猜中局）", "平均得分", "比第一名多");
+    for (int k = 0; k < strategies; k++) {
+        const Standing* sd = &table[order[k]];
+        double lo, hi;
+        wilson(sd->wins, sd->games, &lo, &hi);
+        double solved_mean = sd->wins > 0 ? (double)sd->guess_sum / sd->wins : 0;
+        char win[64], solved[64], score[64], diff[64];
+        snprintf(win, sizeof(win), "%.3f%% [%.3f, %.3f]", 100.0 * sd->wins / sd->games, 100 * lo, 100 * hi);
+        snprintf(solved, sizeof(solved), "%.4f", solved_mean);
+        snprintf(score, sizeof(score), "%.4f ± %.4f", sd->score_sum / sd->games,
+                 halfWidth(sd->score_sum, sd->score_sq, sd->games));
+        if (k == 0) snprintf(diff, sizeof(diff), "-");
+        else snprintf(diff, sizeof(diff), "%+.4f ± %.4f", sd->diff_mean, sd->diff_half);
+        printf("%-4d %-8s %-26s %-20s %-20s %s\n", k + 1, sd->st->name, win, solved, score, diff);
+    }
+    printf("\n猜测成功分布:\n%-8s", "策略");
+    for (int i = 0; i < MAX_ATTEMPTS; i++) printf(" %9d", i + 1);
+    printf(" %9s\n", "失败");
+    for (int k = 0; k < strategies; k++) {
+        const Standing* sd = &table[order[k]];
+        printf("%-8s", sd->st->name);
+        for (int i = 0; i < MAX_ATTEMPTS; i++) printf(" %9lld", sd->distribution[i]);
+        printf(" %9lld\n", sd->games - sd->wins);
+    }
+    return 0;
+}
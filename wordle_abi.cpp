@@ -0,0 +1,129 @@
+#define WORDLE_ABI_BUILD
+#include "wordle_abi.h"
+#include "dictionary.h"
+#include "scoring.h"
+#include <new>
+#include <string.h>
+
+static_assert(WORDLE_WORD_LENGTH == WORD_LENGTH, "接口常量与游戏常量不一致");
+static_assert(WORDLE_PATTERN_COUNT == PATTERN_COUNT, "接口常量与游戏常量不一致");
+static_assert(WORDLE_PATTERN_ALL_GREEN == PATTERN_ALL_GREEN, "接口常量与游戏常量不一致");
+
+struct WordleDict {
+    Dictionary d;
+};
+
+int wordle_abi_version(void) {
+    return WORDLE_ABI_VERSION;
+}
+
+//批量接口共用一个计数数组，猜测词只编码一次，与 scoreBatch 相同
+int wordle_score_pairs(const char* guesses, const char* targets, int n, uint8_t* out) {
+    int invalid = 0;
+    uint8_t g[WORD_LENGTH], t[WORD_LENGTH];
+    uint8_t cnt[MAX_ALPHABET] = {0};
+    for (int i = 0; i < n; i++) {
+        const char* gs = guesses + (size_t)i * WORD_LENGTH;
+        const char* ts = targets + (size_t)i * WORD_LENGTH;
+        if (encodeWord(gs, g) && encodeWord(ts, t)) {
+            out[i] = scoreWithCounts(g, t, cnt);
+        } else {
+            out[i] = WORDLE_PATTERN_INVALID;
+            invalid++;
+        }
+    }
+    return invalid;
+}
+
+int wordle_score_guess(const char* guess, const char* targets, int n, uint8_t* out) {
+    uint8_t g[WORD_LENGTH], t[WORD_LENGTH];
+    uint8_t cnt[MAX_ALPHABET] = {0};
+    if (!encodeWord(guess, g)) return -1;
+    int invalid = 0;
+    for (int i = 0; i < n; i++) {
+        if (encodeWord(targets + (size_t)i * WORD_LENGTH, t)) {
+            out[i] = scoreWithCounts(g, t, cnt);
+        } else {
+            out[i] = WORDLE_PATTERN_INVALID;
+            invalid++;
+        }
+    }
+    return invalid;
+}
+
+int wordle_filter(const char* guess, int pattern, const char* candidates, int n, uint32_t* out_indices) {
+    uint8_t g[WORD_LENGTH], t[WORD_LENGTH];
+    uint8_t cnt[MAX_ALPHABET] = {0};
+    if (pattern < 0 || pattern >= PATTERN_COUNT || !encodeWord(guess, g)) return -1;
+    int kept = 0;
+    for (int i = 0; i < n; i++) {
+        if (encodeWord(candidates + (size_t)i * WORD_LENGTH, t) && scoreWithCounts(g, t, cnt) == pattern) {
+            out_indices[kept++] = (uint32_t)i;
+        }
+    }
+    return kept;
+}
+
+int wordle_decode_pattern(int pattern, uint8_t* out) {
+    if (pattern < 0 || pattern >= PATTERN_COUNT) return 0;
+    int result[WORD_LENGTH];
+    decodePattern((uint8_t)pattern, result);
+    for (int i = 0; i < WORD_LENGTH; i++) out[i] = (uint8_t)(result[i] - 1);
+    return 1;
+}
+
+WordleDict* wordle_dict_load(const char* path) {
+    WordleDict* dict = new (std::nothrow) WordleDict;
+    if (!dict) return nullptr;
+    if (!dictLoadFile(&dict->d, path)) {
+        delete dict;
+        return nullptr;
+    }
+    return dict;
+}
+
+WordleDict* wordle_dict_from_words(const char* words, int n) {
+    WordleDict* dict = new (std::nothrow) WordleDict;
+    if (!dict) return nullptr;
+    std::vector<uint8_t> letters;
+    letters.reserve((size_t)(n > 0 ? n : 0) * WORD_LENGTH);
+    uint8_t w[WORD_LENGTH];
+    for (int i = 0; i < n; i++) {
+        if (encodeWord(words + (size_t)i * WORD_LENGTH, w)) letters.insert(letters.end(), w, w + WORD_LENGTH);
+    }
+    Alphabet a;
+    alphabetLatin(&a);
+    dictBuild(&dict->d, &a, letters, nullptr);
+    return dict;
+}
+
+void wordle_dict_free(WordleDict* dict) {
+    delete dict;
+}
+
+int wordle_dict_size(const WordleDict* dict) {
+    return dict ? dict->d.count : 0;
+}
+
+int wordle_dict_words(const WordleDict* dict, int start, int n, char* out) {
+    // 只有纯英文字母表的单词能写成 ASCII
+    if (!dict || !dict->d.alphabet.latin || dict->d.alphabet.size != 26) return 0;
+    if (start < 0 || n <= 0 || start >= dict->d.count) return 0;
+    if (n > dict->d.count - start) n = dict->d.count - start;
+    for (int i = 0; i < n; i++) {
+        const uint8_t* w = dictWord(&dict->d, start + i);
+        for (int p = 0; p < WORD_LENGTH; p++) out[(size_t)i * WORD_LENGTH + p] = (char)('A' + w[p]);
+    }
+    return n;
+}
+
+int wordle_dict_contains(const WordleDict* dict, const char* words, int n, uint8_t* out) {
+    int found = 0;
+    uint8_t w[WORD_LENGTH];
+    for (int i = 0; i < n; i++) {
+        out[i] = dict && dict->d.alphabet.latin && encodeWord(words + (size_t)i * WORD_LENGTH, w) &&
+                 dictContains(&dict->d, w);
+        found += out[i];
+    }
+    return found;
+}
@@ -0,0 +1,71 @@
+/* Wordle 打分库的 C 接口，供 Python（ctypes/cffi）、Rust 等外部程序调用。
+ * 规则与游戏内 checkGuess 完全一致。
+ *
+ * 约定：
+ *   - 单词为 5 个 ASCII 字母，不区分大小写；多个单词首尾相连紧密存放（第 i 个在 buf + 5 * i），不需要结尾的 '\0'
+ *   - 反馈编码为 0..242：第 i 位 0=灰 1=黄 2=绿，权重 3^i；242 表示全绿
+ *   - 所有缓冲区由调用方提供，库内不复制、不保存调用方的指针
+ *   - 除 wordle_dict_load / wordle_dict_free 外，所有函数都可以多线程同时调用
+ *   - 接口只处理英文字母；非英文字母表的词库可以加载，但 wordle_dict_words / wordle_dict_contains 对其不返回结果
+ */
+#ifndef WORDLE_ABI_H
+#define WORDLE_ABI_H
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(WORDLE_ABI_BUILD)
+#    define WORDLE_API __declspec(dllexport)
+#  else
+#    define WORDLE_API __declspec(dllimport)
+#  endif
+#else
+#  define WORDLE_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WORDLE_ABI_VERSION 1
+#define WORDLE_WORD_LENGTH 5
+#define WORDLE_PATTERN_COUNT 243
+#define WORDLE_PATTERN_ALL_GREEN 242
+#define WORDLE_PATTERN_INVALID 255   /* 输入中含有非字母时写入的反馈 */
+
+typedef struct WordleDict WordleDict;
+
+/* 接口版本，调用方可据此检查与头文件是否一致 */
+WORDLE_API int wordle_abi_version(void);
+
+/* 逐对打分：第 i 对为 guesses[5i..] 与 targets[5i..]，结果写入 out[i]。返回含非字母的对数 */
+WORDLE_API int wordle_score_pairs(const char* guesses, const char* targets, int n, uint8_t* out);
+
+/* 一个猜测词对 n 个目标词打分，结果写入 out[i]。返回含非字母的目标词个数，guess 不合法时返回 -1 */
+WORDLE_API int wordle_score_guess(const char* guess, const char* targets, int n, uint8_t* out);
+
+/* 从 n 个候选词中筛出“猜 guess 会得到 pattern 反馈”的词，把下标（升序）写入 out_indices，
+ * out_indices 至少能放 n 个。返回筛出的个数，参数不合法时返回 -1 */
+WORDLE_API int wordle_filter(const char* guess, int pattern, const char* candidates, int n, uint32_t* out_indices);
+
+/* 把反馈编码展开为每位 0=灰 1=黄 2=绿，out 长度为 5。pattern 不合法时返回 0 */
+WORDLE_API int wordle_decode_pattern(int pattern, uint8_t* out);
+
+/* 读取词库文件（每行一个单词，不合法的行忽略），失败返回 NULL */
+WORDLE_API WordleDict* wordle_dict_load(const char* path);
+/* 由 n 个紧密存放的单词建立词库，会排序去重，不合法的词忽略 */
+WORDLE_API WordleDict* wordle_dict_from_words(const char* words, int n);
+WORDLE_API void wordle_dict_free(WordleDict* dict);
+
+/* 词库中的单词数 */
+WORDLE_API int wordle_dict_size(const WordleDict* dict);
+/* 把从第 start 个起的最多 n 个单词（按字母序，大写）写入 out，返回写入的个数 */
+WORDLE_API int wordle_dict_words(const WordleDict* dict, int start, int n, char* out);
+/* 批量校验：out[i] 为 1 表示 words 中第 i 个词在词库里。返回在词库里的个数 */
+WORDLE_API int wordle_dict_contains(const WordleDict* dict, const char* words, int n, uint8_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif